@@ -0,0 +1,703 @@
+#pragma once
+// ANALOG clipper engine, templated on its modelling choices so every variant
+// shares one implementation and can be compared on sound and on CPU.
+//
+// Policies:
+//   Shaper  - the clip curve: DynamicKnee (tanh knee whose width and drive
+//             follow a fast/slow transient detector), DynamicKneeTable (the
+//             same knee read from AnalogKneeTable.h) or HardClip (+-1)
+//   Slew    - corner of the derivative-gated slew blend: SlewCorner<Hz>
+//   Recon   - post-clip reconstruction LP: TwoPoleRecon<Hz> (blend engages
+//             with a level envelope near the ceiling) or NoRecon
+//   EvenLaw - SILK even-harmonic coefficient. Read by the processor's SILK
+//             stage (pre-clip, base rate): LockedEven or ScaledEven
+//
+// Variants, picked per block at runtime through kVariants (Model):
+//   knee      - DynamicKnee, 8 kHz slew, 7 kHz two-pole recon, LockedEven
+//   kneeTable - as knee, with the knee from the table (within 5.4e-5)
+//   hard      - HardClip, 10 kHz slew, no recon, ScaledEven (the model that
+//               used to live in a forked PluginProcessor_patched.cpp)
+//
+// Lanes are channels (ChannelLanes.h). The transient / level envelopes and
+// the bias memory run once per control tick (one base-rate sample) and are
+// interpolated across it; drive, slew blend, slope gate, knee and post
+// filters run per clipper sample. With recon, ticks where every lane stays
+// below kLevelStart take a linear path: identity knee, DC blocker + recon as a
+// fixed filter. Tests/AnalogEngineBench times the variants.
+//
+// Provides: AnalogEngine::State, laneOf(), setLane(), Rates, ClipCoeffs,
+//           Engine<>, Model, kVariants[], variant()
+
+#include "ChannelLanes.h"
+#include "AnalogKneeADAA.h"
+#include "AnalogKneeTable.h"
+
+#include <cmath>
+
+namespace AnalogEngine {
+using ChannelLanes::Vec;
+using ChannelLanes::Array;
+using ChannelLanes::kLanes;
+
+static constexpr float kSlopeGateStart = 9000.0f; // |dx/dt| where slew rounding starts
+static constexpr float kSlopeGateEnd   = 26000.0f;
+static constexpr float kLevelStart     = 0.55f;   // level envelope where bias / recon engage
+static constexpr float kReconMaxDelta  = 0.20f;   // SILK share of the recon blend
+
+// Envelope control tick, in clipper samples: one base-rate sample
+// (the oversampling factor, up to x64), so their cost stays flat as the factor rises
+static constexpr int kMaxTick = 64;
+
+//==============================================================
+// State and coefficients
+//==============================================================
+struct State
+{
+    // Fast/slow transient detector, slew blend, slope detector
+    Array fastEnv, slowEnv, slew, prev;
+
+    Array biasMemory;
+    Array levelEnv;  // slow envelope of |in| for bias engagement
+    Array dcBlock;   // ultra-low HP state to remove DC without killing even harmonics
+    Array postLP1;   // post-clip HF damping state (pole 1)
+    Array postLP2;   // post-clip HF damping state (pole 2)
+
+    double kneeX1[kLanes] {};  // previous knee input, for ADAA (tracked with ADAA off too)
+};
+
+// One lane of a State as lane 0 of a State of its own, and back: lets one
+// channel run by itself (the channel worker's ANALOG split)
+static constexpr Array State::* kLaneFields[] = { &State::fastEnv, &State::slowEnv, &State::slew, &State::prev,
+                                                  &State::biasMemory, &State::levelEnv, &State::dcBlock,
+                                                  &State::postLP1, &State::postLP2 };
+
+static inline State laneOf (const State& st, int lane) noexcept
+{
+    State single;
+
+    for (auto field : kLaneFields)
+        (single.*field)[0] = (st.*field)[lane];
+
+    single.kneeX1[0] = st.kneeX1[lane];
+    return single;
+}
+
+static inline void setLane (State& st, int lane, const State& single) noexcept
+{
+    for (auto field : kLaneFields)
+        (st.*field)[lane] = (single.*field)[0];
+
+    st.kneeX1[lane] = single.kneeX1[0];
+}
+
+// Per rate (prepare / factor switch)
+struct Rates
+{
+    float envAttackA  = 0.0f;  // level envelope (per control tick)
+    float envReleaseA = 0.0f;
+    float fastEnvA    = 0.0f;  // transient detector (per control tick)
+    float slowEnvA    = 0.0f;
+    float biasA       = 0.0f;  // bias memory (per control tick)
+    float slewA       = 0.0f;  // slew blend one-pole (per sample)
+    float reconA      = 0.0f;  // reconstruction poles (per sample)
+    float dcA         = 0.0f;  // DC blocker (per sample)
+    int   tick        = 1;     // clipper samples per control tick
+};
+
+// Per block, from the SILK knob
+struct ClipCoeffs
+{
+    float silkShape = 0.0f;  // silk^0.8
+    float baseDrive = 1.0f;
+    float sRecon    = 0.0f;  // silkShape^1.56
+    float srEff     = 0.0f;  // sample rate the clipper runs at
+};
+
+static inline Vec clamp01 (Vec v) noexcept
+{
+    return ChannelLanes::min (ChannelLanes::broadcast (1.0f), ChannelLanes::max (ChannelLanes::broadcast (0.0f), v));
+}
+
+static inline Vec smoothStep01 (Vec x) noexcept
+{
+    using namespace ChannelLanes;
+    x = clamp01 (x);
+    return x * x * (broadcast (3.0f) - broadcast (2.0f) * x);
+}
+
+static inline float onePoleAlpha (float cornerHz, float rate) noexcept
+{
+    return std::exp (-2.0f * 3.14159265358979f * cornerHz / rate);
+}
+
+//==============================================================
+// Shaper policies
+//==============================================================
+struct DynamicKnee
+{
+    static constexpr bool kUsesTransient = true;
+
+    static Vec drive (Vec baseDrive, Vec transientNorm) noexcept
+    {
+        using namespace ChannelLanes;
+        return baseDrive * (broadcast (1.0f) - broadcast (0.06f) * transientNorm);
+    }
+
+    static Vec width (Vec transientNorm) noexcept
+    {
+        using namespace ChannelLanes;
+        constexpr float baseKneeWidth = 0.38f;
+        return broadcast (baseKneeWidth) * (broadcast (1.0f) + broadcast (0.35f) * transientNorm);
+    }
+
+    // Soft knee above threshold, identity below
+    static Vec shape (Vec x, Vec width) noexcept
+    {
+        using namespace ChannelLanes;
+        constexpr float threshold = 1.0f;
+
+        const Vec a      = abs (x);
+        const Vec over   = a - broadcast (threshold);
+        const Vec shaped = broadcast (threshold) + ChannelLanes::tanh (over / width) * width;
+
+        return select (a <= broadcast (threshold), x, copySign (shaped, x));
+    }
+
+    // Knee held at this sample's width across the segment from the previous input
+    static float adaaSample (float in, float width, double& x1) noexcept
+    {
+        return AnalogKnee::processAdaa1Sample (in, width, x1);
+    }
+};
+
+// DynamicKnee with g = w tanh (over / w) read bilinearly from the table: no
+// transcendental or divide per sample. ADAA keeps the analytic antiderivative.
+struct DynamicKneeTable : DynamicKnee
+{
+    static Vec shape (Vec x, Vec width) noexcept
+    {
+        using namespace ChannelLanes;
+        constexpr float threshold = 1.0f;
+
+        const Vec a      = abs (x);
+        const Vec shaped = broadcast (threshold) + AnalogKneeTable::lookup (a - broadcast (threshold), width);
+
+        return select (a <= broadcast (threshold), x, copySign (shaped, x));
+    }
+};
+
+struct HardClip
+{
+    static constexpr bool kUsesTransient = false;
+
+    static Vec drive (Vec, Vec) noexcept { return ChannelLanes::broadcast (1.0f); }
+    static Vec width (Vec) noexcept      { return ChannelLanes::broadcast (0.0f); }
+
+    static Vec shape (Vec x, Vec) noexcept
+    {
+        using namespace ChannelLanes;
+        return min (broadcast (1.0f), max (broadcast (-1.0f), x));
+    }
+
+    // F (v) = v^2 / 2 below the ceiling, |v| - 1/2 above
+    static float adaaSample (float in, float, double& x1) noexcept
+    {
+        auto F = [] (double v) { const double a = std::fabs (v); return a <= 1.0 ? 0.5 * a * a : a - 0.5; };
+
+        const double x  = in;
+        const double dx = x - x1;
+        const double m  = 0.5 * (x + x1);
+
+        const double y = (std::fabs (dx) > AnalogKnee::kEps) ? (F (x) - F (x1)) / dx
+                                                             : (m < -1.0 ? -1.0 : (m > 1.0 ? 1.0 : m));
+        x1 = x;
+        return (float) y;
+    }
+};
+
+//==============================================================
+// Slew / recon / even-harmonic policies
+//==============================================================
+template <int CornerHz>
+struct SlewCorner
+{
+    static constexpr float kCornerHz = (float) CornerHz;
+};
+
+template <int CornerHz>
+struct TwoPoleRecon
+{
+    static constexpr bool  kEnabled  = true;
+    static constexpr float kCornerHz = (float) CornerHz;
+};
+
+struct NoRecon
+{
+    static constexpr bool  kEnabled  = false;
+    static constexpr float kCornerHz = 0.0f;
+};
+
+// SILK even coefficient = driveT * scale (silkShape, evenGain), capped at kCap
+struct LockedEven
+{
+    static constexpr float kCap = 0.24f;  // tighter cap to stop high-order even build-up
+
+    // Baseline locked at SILK 0; evenGain (makeSilkCoeffs) adds the SILK delta on top
+    static float scale (float, float evenGain) noexcept
+    {
+        constexpr float evenScale = 1.95f;
+        constexpr float evenTrim  = 0.80f;
+        return evenScale * 0.028f * evenTrim * evenGain;
+    }
+};
+
+struct ScaledEven
+{
+    static constexpr float kCap = 0.40f;  // raised so the boost takes effect at hot levels
+
+    // Grows with SILK from zero (tuned to hardware-like H2/H4/H6 on hot material)
+    static float scale (float silkShape, float) noexcept
+    {
+        constexpr float evenScale = 2.7f;
+        return evenScale * (0.035f + 0.0115f * silkShape) * silkShape;
+    }
+};
+
+//==============================================================
+// Engine
+//==============================================================
+template <typename Shaper, typename Slew, typename Recon, typename EvenLaw>
+struct Engine
+{
+    static Rates makeRates (double sampleRate, int factor)
+    {
+        Rates r;
+        r.tick = factor < 1 ? 1 : (factor > kMaxTick ? kMaxTick : factor);
+
+        const float srEff = (float) sampleRate * (float) (factor < 1 ? 1 : factor);
+
+        if (srEff <= 0.0f)
+            return r;
+
+        const float tickRate = srEff / (float) r.tick;
+
+        auto limit = [] (float a) { return a < 0.0f ? 0.0f : (a > 0.9999999f ? 0.9999999f : a); };
+
+        // Bias envelope follower (1.5 ms attack, 35 ms release)
+        r.envAttackA  = limit (std::exp (-1.0f / (0.0015f * tickRate)));
+        r.envReleaseA = limit (std::exp (-1.0f / (0.035f * tickRate)));
+
+        // Transient envelope smoothing (fast/slow) for analog memory
+        r.fastEnvA = limit (std::exp (-1.0f / (0.0015f * tickRate)));
+        r.slowEnvA = limit (std::exp (-1.0f / (0.035f * tickRate)));
+
+        // Bias memory smoothing (~4 ms in real time)
+        r.biasA = limit (std::exp (-1.0f / (0.004f * tickRate)));
+
+        // Slew limiter and reconstruction corners in REAL TIME, regardless of OS
+        r.slewA  = limit (onePoleAlpha (Slew::kCornerHz, srEff));
+        r.reconA = Recon::kEnabled ? limit (onePoleAlpha (Recon::kCornerHz, srEff)) : 0.0f;
+
+        // DC blocker: ultra-low (~3 Hz) corner at the clipper's processing rate
+        r.dcA = limit (onePoleAlpha (3.0f, srEff));
+
+        return r;
+    }
+
+    static float evenScale (float silkShape, float evenGain) noexcept { return EvenLaw::scale (silkShape, evenGain); }
+
+    // In place; channels[0 .. numChannels) hold numSamples each
+    static void process (State& st, const Rates& r, const ClipCoeffs& c,
+                         float* const* channels, int numChannels, int numSamples, bool antiAlias)
+    {
+        // Without recon the full tick already is that filter (DC blocker + clamp),
+        // so the linear check would cost more than it saves
+        processTicks<Recon::kEnabled> (st, r, c, channels, numChannels, numSamples, antiAlias);
+    }
+
+    // The full model on every tick (no linear fast path); the reference
+    // Tests/AnalogEngineLinearTest holds process() to
+    static void processReference (State& st, const Rates& r, const ClipCoeffs& c,
+                                  float* const* channels, int numChannels, int numSamples, bool antiAlias)
+    {
+        processTicks<false> (st, r, c, channels, numChannels, numSamples, antiAlias);
+    }
+
+private:
+    // Below this bound on |in| the knee is the identity and the level envelope
+    // cannot cross kLevelStart, so the recon blend is constant
+    static constexpr float kLinearCeiling = kLevelStart;
+
+    template <bool kLinearTicks>
+    static void processTicks (State& st, const Rates& r, const ClipCoeffs& c,
+                              float* const* channels, int numChannels, int numSamples, bool antiAlias)
+    {
+        using namespace ChannelLanes;
+
+        Vec x[kMaxTick], inRaw[kMaxTick], transientNorm[kMaxTick];
+
+        const Vec zero = broadcast (0.0f);
+        const Vec one  = broadcast (1.0f);
+
+        for (int start = 0; start < numSamples; start += r.tick)
+        {
+            const int n    = numSamples - start < r.tick ? numSamples - start : r.tick;
+            const Vec invN = broadcast (1.0f / (float) n);
+
+            // Control-rate values are interpolated from the previous tick
+            // (t = 1 on the last sample of the tick)
+            const Vec tnStart = Shaper::kUsesTransient ? transientNormOf (st) : zero;
+
+            Vec sumAbs = zero, peak = zero;
+            for (int j = 0; j < n; ++j)
+            {
+                x[j] = gather (channels, numChannels, start + j);
+
+                const Vec absX = abs (x[j]);
+                sumAbs = sumAbs + absX;
+                peak   = max (peak, absX);
+            }
+
+            // Transient detector: fed the tick's mean |x|
+            Vec tnEnd = zero;
+
+            if constexpr (Shaper::kUsesTransient)
+            {
+                updateTransient (st, r, sumAbs * invN * broadcast (c.baseDrive));
+                tnEnd = transientNormOf (st);
+            }
+
+            if constexpr (kLinearTicks)
+            {
+                if (isLinearTick (st, c, peak))
+                {
+                    linearTick (st, r, c, x, transientNorm, n, tnStart, tnEnd, antiAlias, channels, numChannels, start);
+                    continue;
+                }
+            }
+
+            const Vec rbStart = Recon::kEnabled ? reconBlendOf (st, c) : zero;
+
+            // Per sample: drive, slew blend, slope gate
+            Vec sumAbsIn = zero, peakIn = zero;
+
+            for (int j = 0; j < n; ++j)
+            {
+                const Vec t = broadcast ((float) (j + 1)) * invN;
+                transientNorm[j] = tnStart * (one - t) + tnEnd * t;
+                inRaw[j]         = front (st, r, c, x[j], transientNorm[j]);
+
+                const Vec absIn = abs (inRaw[j]);
+                sumAbsIn = sumAbsIn + absIn;
+                peakIn   = max (peakIn, absIn);
+            }
+
+            // Level envelope + bias memory, on the tick's mean |in|
+            Vec rbEnd = zero;
+
+            if constexpr (Recon::kEnabled)
+            {
+                updateLevel (st, r, c, sumAbsIn * invN);
+                rbEnd = reconBlendOf (st, c);
+            }
+
+            // No lane reaches the knee in this tick: skip the shaper
+            const bool shape = anyLane (peakIn > one);
+
+            for (int j = 0; j < n; ++j)
+            {
+                const Vec t = broadcast ((float) (j + 1)) * invN;
+                const Vec y = knee (st, inRaw[j], transientNorm[j], shape, antiAlias, numChannels);
+
+                scatter (post (st, r, y, rbStart * (one - t) + rbEnd * t), channels, numChannels, start + j);
+            }
+        }
+    }
+
+    // Decided before the front runs: drive only lowers the gain (transient
+    // term >= 0) and the slew blend mixes pre with a one-pole of pre, so
+    // |in| <= max (peak |x| * baseDrive, |slew state|) over the tick
+    static bool isLinearTick (const State& st, const ClipCoeffs& c, Vec peak) noexcept
+    {
+        using namespace ChannelLanes;
+
+        const Vec ceiling = broadcast (kLinearCeiling);
+        const Vec bound   = max (Shaper::kUsesTransient ? peak * broadcast (c.baseDrive) : peak,
+                                 abs (load (st.slew)));
+
+        return ! anyLane (max (bound, load (st.levelEnv)) > ceiling);
+    }
+
+    // One tick of the linear region: the front and envelopes run as usual,
+    // the knee is the identity and the DC blocker + recon are a fixed linear
+    // filter (constant blend)
+    static void linearTick (State& st, const Rates& r, const ClipCoeffs& c, const Vec* x, Vec* transientNorm,
+                            int n, Vec tnStart, Vec tnEnd, bool antiAlias,
+                            float* const* channels, int numChannels, int start) noexcept
+    {
+        using namespace ChannelLanes;
+
+        const Vec one  = broadcast (1.0f);
+        const Vec invN = broadcast (1.0f / (float) n);
+
+        Vec inRaw[kMaxTick];
+        Vec sumAbsIn = broadcast (0.0f);
+
+        for (int j = 0; j < n; ++j)
+        {
+            const Vec t = broadcast ((float) (j + 1)) * invN;
+            transientNorm[j] = tnStart * (one - t) + tnEnd * t;
+            inRaw[j]         = front (st, r, c, x[j], transientNorm[j]);
+            sumAbsIn         = sumAbsIn + abs (inRaw[j]);
+        }
+
+        if (antiAlias)
+        {
+            // Both ends of every ADAA segment are below the knee: the two-tap mean
+            for (int j = 0; j < n; ++j)
+                inRaw[j] = knee (st, inRaw[j], transientNorm[j], false, true, numChannels);
+        }
+        else
+        {
+            Array last;
+            store (inRaw[n - 1], last);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                st.kneeX1[ch] = last[ch];
+        }
+
+        const Vec dcA = broadcast (r.dcA), dcB = broadcast (1.0f - r.dcA);
+        const Vec lo  = broadcast (-2.0f), hi = broadcast (2.0f);
+
+        Vec dcBlock = load (st.dcBlock);
+
+        if constexpr (Recon::kEnabled)
+        {
+            updateLevel (st, r, c, sumAbsIn * invN);
+
+            const Vec reconBlend = reconBlendOf (st, c);
+            const Vec reconA = broadcast (r.reconA), reconB = broadcast (1.0f - r.reconA);
+
+            Vec postLP1 = load (st.postLP1);
+            Vec postLP2 = load (st.postLP2);
+
+            for (int j = 0; j < n; ++j)
+            {
+                onePole (dcBlock, dcA, dcB, inRaw[j]);
+                const Vec y = inRaw[j] - dcBlock;
+
+                onePole (postLP1, reconA, reconB, y);
+                onePole (postLP2, reconA, reconB, postLP1);
+
+                scatter (min (hi, max (lo, y + reconBlend * (postLP2 - y))), channels, numChannels, start + j);
+            }
+
+            store (postLP1, st.postLP1);
+            store (postLP2, st.postLP2);
+        }
+        else
+        {
+            for (int j = 0; j < n; ++j)
+            {
+                onePole (dcBlock, dcA, dcB, inRaw[j]);
+                scatter (min (hi, max (lo, inRaw[j] - dcBlock)), channels, numChannels, start + j);
+            }
+        }
+
+        store (dcBlock, st.dcBlock);
+    }
+
+    static Vec transientNormOf (const State& st) noexcept
+    {
+        using namespace ChannelLanes;
+
+        const Vec transient = max (broadcast (0.0f), load (st.fastEnv) - load (st.slowEnv));
+        return smoothStep01 (transient / broadcast (0.25f));
+    }
+
+    static Vec reconBlendOf (const State& st, const ClipCoeffs& c) noexcept
+    {
+        using namespace ChannelLanes;
+
+        const Vec env = load (st.levelEnv);
+
+        // recon engages strongly once we're truly near the ceiling
+        const Vec reconT = select (env > broadcast (0.55f),
+                                   clamp01 ((env - broadcast (0.55f)) / broadcast (1.00f - 0.55f)),
+                                   broadcast (0.0f));
+
+        Vec reconBlend = reconT * reconT * reconT;
+
+        // back off HF damping to match hardware "air" at silk=0
+        const Vec reconBlendBase = clamp01 (broadcast (0.80f) * reconBlend);
+        return clamp01 (reconBlendBase + broadcast (kReconMaxDelta * c.sRecon));
+    }
+
+    static void updateTransient (State& st, const Rates& r, Vec absPre) noexcept
+    {
+        using namespace ChannelLanes;
+
+        Vec fastEnv = load (st.fastEnv);
+        Vec slowEnv = load (st.slowEnv);
+        onePole (fastEnv, broadcast (r.fastEnvA), broadcast (1.0f - r.fastEnvA), absPre);
+        onePole (slowEnv, broadcast (r.slowEnvA), broadcast (1.0f - r.slowEnvA), absPre);
+        store (fastEnv, st.fastEnv);
+        store (slowEnv, st.slowEnv);
+    }
+
+    static void updateLevel (State& st, const Rates& r, const ClipCoeffs& c, Vec absIn) noexcept
+    {
+        using namespace ChannelLanes;
+
+        // Slow envelope follower of |in| (so bias doesn't "follow" the sine)
+        Vec env = load (st.levelEnv);
+        const Mask attack = absIn > env;
+        env = select (attack, broadcast (r.envAttackA),  broadcast (r.envReleaseA)) * env
+            + select (attack, broadcast (1.0f - r.envAttackA), broadcast (1.0f - r.envReleaseA)) * absIn;
+        store (env, st.levelEnv);
+
+        // Bias envelope (engages near clipping)
+        constexpr float levelEnd = 1.45f;
+
+        const Vec levelT = select (env > broadcast (kLevelStart),
+                                   clamp01 ((env - broadcast (kLevelStart)) / broadcast (levelEnd - kLevelStart)),
+                                   broadcast (0.0f));
+
+        // Baseline even content at SILK 0, more with SILK
+        constexpr float biasTrim = 1.20f;   // +1.6 dB-ish on H2/H4
+        constexpr float biasBase = 0.018f * biasTrim;
+        constexpr float biasSilk = 0.031f * biasTrim;
+
+        const Vec targetBias = broadcast (biasBase + biasSilk * c.silkShape) * levelT;
+
+        // Micro "memory" on bias itself (kept running; the shaper no longer reads it)
+        Vec biasMemory = load (st.biasMemory);
+        onePole (biasMemory, broadcast (r.biasA), broadcast (1.0f - r.biasA), targetBias);
+        store (biasMemory, st.biasMemory);
+    }
+
+    // Drive, then slew blend only when corners are steep (Lavry-style edge rounding)
+    static Vec front (State& st, const Rates& r, const ClipCoeffs& c, Vec x, Vec transientNorm) noexcept
+    {
+        using namespace ChannelLanes;
+
+        Vec pre = x;
+
+        if constexpr (Shaper::kUsesTransient)
+            pre = x * Shaper::drive (broadcast (c.baseDrive), transientNorm);
+
+        Vec slewed = load (st.slew);
+        onePole (slewed, broadcast (r.slewA), broadcast (1.0f - r.slewA), pre);
+        store (slewed, st.slew);
+
+        // slope detector (stable across oversampling)
+        const Vec dx = pre - load (st.prev);
+        store (pre, st.prev);
+
+        const Vec slopePerSec = abs (dx) * broadcast (c.srEff);
+
+        // smoothstep gate
+        Vec g = (slopePerSec - broadcast (kSlopeGateStart)) / broadcast (kSlopeGateEnd - kSlopeGateStart);
+        g = clamp01 (g);
+        g = g * g * (broadcast (3.0f) - broadcast (2.0f) * g);
+
+        // maxBlend controls “how Lavry” the rounding is
+        constexpr float maxBlend = 0.55f;
+        const Vec blend = broadcast (maxBlend) * g;
+
+        return pre + blend * (slewed - pre);
+    }
+
+    // shape == false: the caller knows every lane is below the ceiling (identity)
+    static Vec knee (State& st, Vec inRaw, Vec transientNorm, bool shape, bool antiAlias, int numChannels) noexcept
+    {
+        using namespace ChannelLanes;
+
+        const Vec width = Shaper::width (transientNorm);
+
+        Array in;
+        store (inRaw, in);
+
+        if (antiAlias)
+        {
+            // Double precision, one lane at a time; below the ceiling this is the two-tap mean
+            Array w, out;
+            store (width, w);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                out[ch] = Shaper::adaaSample (in[ch], w[ch], st.kneeX1[ch]);
+
+            return load (out);
+        }
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            st.kneeX1[ch] = in[ch];
+
+        return shape ? Shaper::shape (inRaw, width) : inRaw;
+    }
+
+    static Vec post (State& st, const Rates& r, Vec y, Vec reconBlend) noexcept
+    {
+        using namespace ChannelLanes;
+
+        // DC blocker (very low corner) – keeps the expensive even series, removes DC drift
+        Vec dcBlock = load (st.dcBlock);
+        onePole (dcBlock, broadcast (r.dcA), broadcast (1.0f - r.dcA), y);
+        store (dcBlock, st.dcBlock);
+        y = y - dcBlock;
+
+        if constexpr (Recon::kEnabled)
+        {
+            // Extra HF damping when driven (models converter reconstruction smoothing)
+            const Vec reconA = broadcast (r.reconA), reconB = broadcast (1.0f - r.reconA);
+            Vec postLP1 = load (st.postLP1);
+            Vec postLP2 = load (st.postLP2);
+            onePole (postLP1, reconA, reconB, y);
+            onePole (postLP2, reconA, reconB, postLP1);
+            store (postLP1, st.postLP1);
+            store (postLP2, st.postLP2);
+
+            y = y + reconBlend * (postLP2 - y);
+        }
+
+        return min (broadcast (2.0f), max (broadcast (-2.0f), y));
+    }
+};
+
+//==============================================================
+// Variants
+//==============================================================
+using KneeEngine      = Engine<DynamicKnee,      SlewCorner<8000>,  TwoPoleRecon<7000>, LockedEven>;
+using KneeTableEngine = Engine<DynamicKneeTable, SlewCorner<8000>,  TwoPoleRecon<7000>, LockedEven>;
+using HardEngine      = Engine<HardClip,         SlewCorner<10000>, NoRecon,            ScaledEven>;
+
+enum class Model
+{
+    knee = 0,   // default
+    hard,
+    kneeTable,
+    numModels
+};
+
+struct Variant
+{
+    const char* name;
+    Rates (*makeRates) (double sampleRate, int factor);
+    void  (*process) (State&, const Rates&, const ClipCoeffs&, float* const*, int, int, bool);
+    float (*evenScale) (float silkShape, float evenGain);
+    float evenCap;
+};
+
+static constexpr Variant kVariants[(int) Model::numModels] =
+{
+    { "KNEE", &KneeEngine::makeRates, &KneeEngine::process, &KneeEngine::evenScale, LockedEven::kCap },
+    { "HARD", &HardEngine::makeRates, &HardEngine::process, &HardEngine::evenScale, ScaledEven::kCap },
+    { "KNEE TABLE", &KneeTableEngine::makeRates, &KneeTableEngine::process, &KneeTableEngine::evenScale, LockedEven::kCap },
+};
+
+static inline const Variant& variant (int model) noexcept
+{
+    return kVariants[model < 0 || model >= (int) Model::numModels ? 0 : model];
+}
+
+} // namespace AnalogEngine
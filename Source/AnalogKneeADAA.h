@@ -0,0 +1,76 @@
+#pragma once
+// Antiderivative anti-aliasing (ADAA) for the ANALOG clipper's soft knee.
+//
+// The knee (softClip in applyClipperAnalogSample) and its antiderivative:
+//
+//   f (v; k) = v                                          |v| <= 1
+//            = sign (v) * (1 + k tanh ((|v| - 1) / k))     otherwise
+//
+//   F (v; k) = v^2 / 2                                     |v| <= 1
+//            = 1/2 + (a - 1) + k^2 log cosh ((a - 1) / k), a = |v|
+//
+//   y[n] = (F (x[n]; k[n]) - F (x[n-1]; k[n])) / (x[n] - x[n-1])
+//
+// The knee width k follows the transient detector and so changes per sample.
+// It is held constant over each segment: both ends are evaluated with k[n],
+// so y[n] is the exact mean of f (.; k[n]) between the two inputs. (Mixing
+// k[n] and k[n-1] would make the difference quotient blow up as dx -> 0.)
+//
+// First order only: a second-order divided difference spans three samples
+// and two knee widths. Same side effects as the DIGITAL ADAA
+// (FruityMatchADAA.h): half a sample of delay, and (x0 + x1) / 2 below the
+// knee, i.e. a gentle top-octave rolloff at x1 that x2 moves out of band.
+//
+// Measured (Tests/AnalogKneeAdaaTest, 5 kHz sine): the knee's own aliases
+// drop 13 dB at x1 / +1.9 dB over, 4 dB at +6 dB, 14 dB at x2. Through the
+// whole engine the front's slope gate aliases as much and is not covered, so
+// the output gains only 2-4 dB.
+//
+// Provides: AnalogKnee::curve(), AnalogKnee::antiderivative1(), AnalogKnee::processAdaa1Sample()
+
+#include <cmath>
+
+namespace AnalogKnee {
+
+// Below this input difference the quotient loses precision: evaluate f at the midpoint
+static constexpr double kEps = 1.0e-5;
+
+static inline double curve (double v, double knee) noexcept
+{
+    const double a = std::fabs (v);
+
+    if (a <= 1.0)
+        return v;
+
+    return std::copysign (1.0 + knee * std::tanh ((a - 1.0) / knee), v);
+}
+
+// F = integral of f from 0: even, continuous in v and k
+static inline double antiderivative1 (double v, double knee) noexcept
+{
+    const double a = std::fabs (v);
+
+    if (a <= 1.0)
+        return 0.5 * a * a;
+
+    // log cosh (t) = t + log1p (e^-2t) - log 2, stable for large t
+    const double t       = (a - 1.0) / knee;
+    const double logCosh = t + std::log1p (std::exp (-2.0 * t)) - 0.693147180559945309;
+
+    return 0.5 + (a - 1.0) + knee * knee * logCosh;
+}
+
+// x1: previous input, updated in place
+static inline float processAdaa1Sample (float in, float knee, double& x1) noexcept
+{
+    const double x  = in;
+    const double k  = knee;
+    const double dx = x - x1;
+
+    const double y = (std::fabs (dx) > kEps) ? (antiderivative1 (x, k) - antiderivative1 (x1, k)) / dx
+                                             : curve (0.5 * (x + x1), k);
+    x1 = x;
+    return (float) y;
+}
+
+} // namespace AnalogKnee
@@ -0,0 +1,106 @@
+#pragma once
+// Table form of the ANALOG soft knee, for AnalogEngine::DynamicKneeTable.
+//
+// The knee above the ceiling is 1 + g (over, width) with
+//
+//   g (o; w) = w tanh (o / w),   o = |v| - 1 >= 0,   w in [kWidthMin, kWidthMax]
+//
+// (DynamicKnee::width spans 0.38 .. 0.38 * 1.35). g is tabulated on a uniform
+// kOverSteps x kWidthSteps grid and read back bilinearly, so a knee sample is
+// a few multiplies and four loads instead of a tanh rational and a divide.
+// Overshoot past kOverMax reads the last column, i.e. the knee is already
+// within 8.5e-6 of its asymptote 1 + w there.
+//
+// (kOverSteps + 1) x (kWidthSteps + 1) floats = 257 x 13 = 13.4 KB, one row per
+// width; a lookup touches two neighbouring rows, so it stays in L1.
+//
+// Error bound vs the analytic knee (double tanh), max over o in [0, 8],
+// w in [kWidthMin, kWidthMax]:
+//   256 x 8: 8.8e-5    256 x 12: 5.4e-5    256 x 16: 4.4e-5    384 x 16: 2.7e-5
+// i.e. <= 5.4e-5 (-85 dBFS) at the grid used here, and 0 on the identity
+// side. The error is dominated by curvature along w, where the grid is coarse.
+//
+// The table is built once at load time (std::tanh, 3341 entries), never on
+// the audio thread.
+//
+// Provides: AnalogKneeTable::Table, AnalogKneeTable::kTable, AnalogKneeTable::lookup()
+
+#include "ChannelLanes.h"
+
+#include <cmath>
+
+namespace AnalogKneeTable {
+static constexpr int   kOverSteps  = 256;
+static constexpr int   kWidthSteps = 12;
+static constexpr float kOverMax    = 3.0f;
+static constexpr float kWidthMin   = 0.38f;
+static constexpr float kWidthMax   = 0.38f * 1.35f;
+
+static constexpr int kRowLength = kOverSteps + 1;
+
+struct Table
+{
+    alignas (16) float g[(kWidthSteps + 1) * kRowLength];
+
+    static Table build() noexcept
+    {
+        Table t {};
+
+        for (int j = 0; j <= kWidthSteps; ++j)
+        {
+            const double w = kWidthMin + (kWidthMax - kWidthMin) * (double) j / (double) kWidthSteps;
+
+            for (int i = 0; i <= kOverSteps; ++i)
+            {
+                const double o = kOverMax * (double) i / (double) kOverSteps;
+                t.g[j * kRowLength + i] = (float) (w * std::tanh (o / w));
+            }
+        }
+
+        return t;
+    }
+};
+
+inline const Table kTable = Table::build();
+
+// g (over, width) per lane; over < 0 reads 0, width is clamped to the table
+static inline ChannelLanes::Vec lookup (ChannelLanes::Vec over, ChannelLanes::Vec width) noexcept
+{
+    using namespace ChannelLanes;
+
+    constexpr float overScale  = (float) kOverSteps / kOverMax;
+    constexpr float widthScale = (float) kWidthSteps / (kWidthMax - kWidthMin);
+
+    // Grid coordinates, held just below the last node so the upper corner stays in the table
+    const Vec u = min (broadcast ((float) kOverSteps - 1.0f / 16384.0f),
+                       max (broadcast (0.0f), over * broadcast (overScale)));
+    const Vec v = min (broadcast ((float) kWidthSteps - 1.0f / 65536.0f),
+                       max (broadcast (0.0f), (width - broadcast (kWidthMin)) * broadcast (widthScale)));
+
+    const Vec iu = truncate (u);
+    const Vec iv = truncate (v);
+
+    // Row-major offset of the lower corner (exact in float)
+    Array offset;
+    store (iv * broadcast ((float) kRowLength) + iu, offset);
+
+    Array g00, g01, g10, g11;
+
+    for (int l = 0; l < kLanes; ++l)
+    {
+        const float* corner = kTable.g + (int) offset[l];
+        g00[l] = corner[0];
+        g01[l] = corner[1];
+        g10[l] = corner[kRowLength];
+        g11[l] = corner[kRowLength + 1];
+    }
+
+    const Vec fu = u - iu;
+    const Vec fv = v - iv;
+
+    const Vec lo = load (g00) + fu * (load (g01) - load (g00));
+    const Vec hi = load (g10) + fu * (load (g11) - load (g10));
+    return lo + fv * (hi - lo);
+}
+
+} // namespace AnalogKneeTable
@@ -0,0 +1,76 @@
+#pragma once
+// Auto oversampling controller (realtime only).
+//
+// The user's factor is a ceiling. Once per block the processor hands over
+// how long processBlock took; the load (time / block deadline) is smoothed
+// over kLoadSeconds and compared with the budget:
+//
+//   - above kBudget: one factor down
+//   - below kBudget * kStepUp: one factor up (one step roughly doubles the
+//     oversampled part of the cost, so the next factor should still fit)
+//   - otherwise: stay
+//
+// After any factor change (auto or user) the processor calls hold(), so the
+// load settles for kHoldSeconds before the next decision. Free of JUCE and
+// of the clock, so Tests/AutoOversampleTest can drive it with simulated
+// timings.
+//
+// Provides: AutoOversample::Controller, kBudget, kStepUp, kLoadSeconds, kHoldSeconds
+
+#include <cmath>
+
+namespace AutoOversample {
+static constexpr float kBudget      = 0.30f;  // share of the block deadline this instance may use
+static constexpr float kStepUp      = 0.40f;  // step up below kBudget * this
+static constexpr float kLoadSeconds = 0.30f;  // load smoothing time constant
+static constexpr float kHoldSeconds = 1.0f;   // minimum time between steps
+
+struct Controller
+{
+    int   ceiling     = 0;      // automatic ceiling on the factor index
+    float load        = 0.0f;   // smoothed processBlock time / deadline
+    int   holdSamples = 0;
+
+    // Starts from the top factor, with the load history cleared
+    void reset (int maxIndex) noexcept
+    {
+        ceiling     = maxIndex;
+        load        = 0.0f;
+        holdSamples = 0;
+    }
+
+    void hold (double sampleRate) noexcept
+    {
+        holdSamples = (int) (kHoldSeconds * sampleRate);
+    }
+
+    // One block took elapsedSeconds; updates the ceiling for the next block
+    void update (double elapsedSeconds, int numSamples, double sampleRate, int userIndex) noexcept
+    {
+        if (sampleRate <= 0.0 || numSamples <= 0)
+            return;
+
+        const double deadline = (double) numSamples / sampleRate;
+
+        const float blockLoad = (float) (elapsedSeconds / deadline);
+        const float alpha     = (float) std::exp (-deadline / (double) kLoadSeconds);
+        load = alpha * load + (1.0f - alpha) * blockLoad;
+
+        if (holdSamples > 0)
+        {
+            holdSamples -= numSamples;
+            return;
+        }
+
+        const int current = ceiling < userIndex ? ceiling : userIndex;
+
+        if (load > kBudget && current > 0)
+            ceiling = current - 1;
+        else if (load < kBudget * kStepUp && current < userIndex)
+            ceiling = current + 1;
+        else
+            ceiling = current;
+    }
+};
+
+} // namespace AutoOversample
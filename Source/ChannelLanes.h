@@ -0,0 +1,195 @@
+#pragma once
+// Channels as SIMD lanes, for the per-sample recursive stages (SILK, tone
+// match, analog clipper, K-weighted meter).
+//
+// Their state is struct-of-arrays: every field is an Array with one lane per
+// channel (lane 0 = L, lane 1 = R, lanes 2..3 spare for wider layouts), so a
+// one-pole update for all channels is a single load / mul / add / store.
+// Vec is the register form of an Array; Mask is a per-lane comparison result
+// for branch-free selects.
+//
+// The same arithmetic runs on every lane, in the order the scalar code used,
+// so each channel's output is the scalar result (bit-identical unless the
+// compiler contracts the scalar path into FMAs). Unused lanes carry zeros.
+//
+// Provides: ChannelLanes::Array, ChannelLanes::Vec, ChannelLanes::Mask and
+// the arithmetic / truncate / select / anyLane / tanh helpers below.
+
+#include "FastMath.h"
+
+#include <cmath>
+
+namespace ChannelLanes {
+static constexpr int kLanes = 4;
+
+struct alignas (16) Array
+{
+    float v[kLanes] {};
+
+    float&       operator[] (int lane) noexcept       { return v[lane]; }
+    const float& operator[] (int lane) const noexcept { return v[lane]; }
+};
+
+#if FASTMATH_SSE2
+struct Vec  { __m128 r; };
+struct Mask { __m128 r; };
+
+static inline Vec load (const Array& a) noexcept            { return { _mm_load_ps (a.v) }; }
+static inline void store (const Vec& x, Array& a) noexcept  { _mm_store_ps (a.v, x.r); }
+static inline Vec broadcast (float x) noexcept              { return { _mm_set1_ps (x) }; }
+
+static inline Vec operator+ (Vec a, Vec b) noexcept { return { _mm_add_ps (a.r, b.r) }; }
+static inline Vec operator- (Vec a, Vec b) noexcept { return { _mm_sub_ps (a.r, b.r) }; }
+static inline Vec operator* (Vec a, Vec b) noexcept { return { _mm_mul_ps (a.r, b.r) }; }
+static inline Vec operator/ (Vec a, Vec b) noexcept { return { _mm_div_ps (a.r, b.r) }; }
+
+static inline Vec min (Vec a, Vec b) noexcept { return { _mm_min_ps (a.r, b.r) }; }
+static inline Vec max (Vec a, Vec b) noexcept { return { _mm_max_ps (a.r, b.r) }; }
+static inline Vec abs (Vec a) noexcept        { return { _mm_andnot_ps (_mm_set1_ps (-0.0f), a.r) }; }
+
+// Toward zero, for |a| < 2^31
+static inline Vec truncate (Vec a) noexcept   { return { _mm_cvtepi32_ps (_mm_cvttps_epi32 (a.r)) }; }
+
+// |magnitude| with the sign of sign
+static inline Vec copySign (Vec magnitude, Vec sign) noexcept
+{
+    const __m128 signBit = _mm_set1_ps (-0.0f);
+    return { _mm_or_ps (_mm_andnot_ps (signBit, magnitude.r), _mm_and_ps (signBit, sign.r)) };
+}
+
+static inline Mask operator> (Vec a, Vec b) noexcept  { return { _mm_cmpgt_ps (a.r, b.r) }; }
+static inline Mask operator<= (Vec a, Vec b) noexcept { return { _mm_cmple_ps (a.r, b.r) }; }
+
+static inline Vec select (Mask m, Vec ifTrue, Vec ifFalse) noexcept
+{
+    return { _mm_or_ps (_mm_and_ps (m.r, ifTrue.r), _mm_andnot_ps (m.r, ifFalse.r)) };
+}
+
+static inline bool anyLane (Mask m) noexcept { return _mm_movemask_ps (m.r) != 0; }
+
+static inline Vec tanh (Vec x) noexcept { return { FastMath::tanh4 (x.r) }; }
+#elif FASTMATH_NEON
+struct Vec  { float32x4_t r; };
+struct Mask { uint32x4_t  r; };
+
+static inline Vec load (const Array& a) noexcept            { return { vld1q_f32 (a.v) }; }
+static inline void store (const Vec& x, Array& a) noexcept  { vst1q_f32 (a.v, x.r); }
+static inline Vec broadcast (float x) noexcept              { return { vdupq_n_f32 (x) }; }
+
+static inline Vec operator+ (Vec a, Vec b) noexcept { return { vaddq_f32 (a.r, b.r) }; }
+static inline Vec operator- (Vec a, Vec b) noexcept { return { vsubq_f32 (a.r, b.r) }; }
+static inline Vec operator* (Vec a, Vec b) noexcept { return { vmulq_f32 (a.r, b.r) }; }
+
+static inline Vec operator/ (Vec a, Vec b) noexcept
+{
+   #if defined (__aarch64__) || defined (_M_ARM64)
+    return { vdivq_f32 (a.r, b.r) };
+   #else
+    float32x4_t r = vrecpeq_f32 (b.r);
+    r = vmulq_f32 (r, vrecpsq_f32 (b.r, r));
+    r = vmulq_f32 (r, vrecpsq_f32 (b.r, r));
+    return { vmulq_f32 (a.r, r) };
+   #endif
+}
+
+static inline Vec min (Vec a, Vec b) noexcept { return { vminq_f32 (a.r, b.r) }; }
+static inline Vec max (Vec a, Vec b) noexcept { return { vmaxq_f32 (a.r, b.r) }; }
+static inline Vec abs (Vec a) noexcept        { return { vabsq_f32 (a.r) }; }
+static inline Vec truncate (Vec a) noexcept   { return { vcvtq_f32_s32 (vcvtq_s32_f32 (a.r)) }; }
+
+static inline Vec copySign (Vec magnitude, Vec sign) noexcept
+{
+    return { vbslq_f32 (vdupq_n_u32 (0x80000000u), sign.r, magnitude.r) };
+}
+
+static inline Mask operator> (Vec a, Vec b) noexcept  { return { vcgtq_f32 (a.r, b.r) }; }
+static inline Mask operator<= (Vec a, Vec b) noexcept { return { vcleq_f32 (a.r, b.r) }; }
+
+static inline Vec select (Mask m, Vec ifTrue, Vec ifFalse) noexcept { return { vbslq_f32 (m.r, ifTrue.r, ifFalse.r) }; }
+
+static inline bool anyLane (Mask m) noexcept
+{
+    const uint32x2_t half = vorr_u32 (vget_low_u32 (m.r), vget_high_u32 (m.r));
+    return (vget_lane_u32 (half, 0) | vget_lane_u32 (half, 1)) != 0;
+}
+
+static inline Vec tanh (Vec x) noexcept { return { FastMath::tanh4 (x.r) }; }
+#else
+struct Vec  { float r[kLanes]; };
+struct Mask { bool  r[kLanes]; };
+
+template <typename Op>
+static inline Vec perLane (Vec a, Vec b, Op op) noexcept
+{
+    Vec out;
+    for (int l = 0; l < kLanes; ++l)
+        out.r[l] = op (a.r[l], b.r[l]);
+    return out;
+}
+
+static inline Vec load (const Array& a) noexcept            { Vec x; for (int l = 0; l < kLanes; ++l) x.r[l] = a.v[l]; return x; }
+static inline void store (const Vec& x, Array& a) noexcept  { for (int l = 0; l < kLanes; ++l) a.v[l] = x.r[l]; }
+static inline Vec broadcast (float x) noexcept              { Vec out; for (auto& r : out.r) r = x; return out; }
+
+static inline Vec operator+ (Vec a, Vec b) noexcept { return perLane (a, b, [] (float p, float q) { return p + q; }); }
+static inline Vec operator- (Vec a, Vec b) noexcept { return perLane (a, b, [] (float p, float q) { return p - q; }); }
+static inline Vec operator* (Vec a, Vec b) noexcept { return perLane (a, b, [] (float p, float q) { return p * q; }); }
+static inline Vec operator/ (Vec a, Vec b) noexcept { return perLane (a, b, [] (float p, float q) { return p / q; }); }
+
+static inline Vec min (Vec a, Vec b) noexcept { return perLane (a, b, [] (float p, float q) { return q < p ? q : p; }); }
+static inline Vec max (Vec a, Vec b) noexcept { return perLane (a, b, [] (float p, float q) { return p < q ? q : p; }); }
+static inline Vec abs (Vec a) noexcept        { return perLane (a, a, [] (float p, float) { return std::abs (p); }); }
+static inline Vec truncate (Vec a) noexcept   { return perLane (a, a, [] (float p, float) { return (float) (int) p; }); }
+
+static inline Vec copySign (Vec magnitude, Vec sign) noexcept
+{
+    return perLane (magnitude, sign, [] (float p, float q) { return std::copysign (p, q); });
+}
+
+static inline Mask operator> (Vec a, Vec b) noexcept  { Mask m; for (int l = 0; l < kLanes; ++l) m.r[l] = a.r[l] > b.r[l];  return m; }
+static inline Mask operator<= (Vec a, Vec b) noexcept { Mask m; for (int l = 0; l < kLanes; ++l) m.r[l] = a.r[l] <= b.r[l]; return m; }
+
+static inline Vec select (Mask m, Vec ifTrue, Vec ifFalse) noexcept
+{
+    Vec out;
+    for (int l = 0; l < kLanes; ++l)
+        out.r[l] = m.r[l] ? ifTrue.r[l] : ifFalse.r[l];
+    return out;
+}
+
+static inline bool anyLane (Mask m) noexcept
+{
+    for (bool b : m.r)
+        if (b)
+            return true;
+    return false;
+}
+
+static inline Vec tanh (Vec x) noexcept { Vec out; for (int l = 0; l < kLanes; ++l) out.r[l] = FastMath::tanh (x.r[l]); return out; }
+#endif
+
+// Lanes from / to channel buffers at sample index i (lanes >= numChannels read as 0)
+static inline Vec gather (float* const* channels, int numChannels, int i) noexcept
+{
+    Array a;
+    for (int ch = 0; ch < numChannels; ++ch)
+        a[ch] = channels[ch][i];
+    return load (a);
+}
+
+static inline void scatter (const Vec& x, float* const* channels, int numChannels, int i) noexcept
+{
+    Array a;
+    store (x, a);
+    for (int ch = 0; ch < numChannels; ++ch)
+        channels[ch][i] = a[ch];
+}
+
+// One-pole lowpass in place: state = alpha * state + (1 - alpha) * x
+static inline Vec onePole (Vec& state, Vec alpha, Vec oneMinusAlpha, Vec x) noexcept
+{
+    state = alpha * state + oneMinusAlpha * x;
+    return state;
+}
+
+} // namespace ChannelLanes
@@ -0,0 +1,168 @@
+#pragma once
+// Pre-spawned realtime helper thread that runs one job in parallel with the
+// audio thread.
+//
+// Used to process the second channel of the oversampled clip stage while the
+// audio thread does the first. The audio thread never waits longer than it
+// chooses to:
+//
+//   isFree() – false while the worker is still winding down an abandoned
+//              job (which may touch that job's context): run serially then
+//   post()   – publish the job (atomics only); only after isFree()
+//   finish() – after doing its own share: if the worker has not claimed the
+//              job yet, it is withdrawn; if the worker is running it, the
+//              caller spin-waits up to maxWaitSeconds, then abandons it.
+//              Returns true only when the worker completed the job.
+//
+// Jobs must be restartable: they work on private copies (input and state)
+// that the caller commits on true, and the caller does the work itself on
+// false. A preempted or slow worker then costs at most maxWaitSeconds, and
+// the output does not depend on scheduling. When no core is free the worker
+// simply never claims anything and processing degrades to serial.
+//
+// The worker runs as a realtime thread (juce::Thread::RealtimeOptions: a
+// time-constraint thread on macOS, realtime scheduling elsewhere when the
+// system allows it, else the highest normal priority). It spins for
+// kSpinSeconds after its last job so back-to-back jobs (one per oversampled
+// sub-block) are picked up immediately, then naps in kNapMicroseconds steps
+// until there is work again.
+//
+// start() / stop() allocate and join: message thread only.
+
+#include "JuceHeader.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define GOREKLIP_WORKER_PAUSE() _mm_pause()
+#elif defined (__aarch64__) || defined (_M_ARM64)
+ #define GOREKLIP_WORKER_PAUSE() __asm__ __volatile__ ("yield")
+#else
+ #define GOREKLIP_WORKER_PAUSE() ((void) 0)
+#endif
+
+class ChannelWorker : private juce::Thread
+{
+public:
+    using Job = void (*) (void* context);
+
+    ChannelWorker() : juce::Thread ("GOREKLIP channel worker") {}
+    ~ChannelWorker() override { stop(); }
+
+    // Only spawns when there is a second core to run on. The block size and
+    // rate (when known) tell the scheduler how much time each period needs.
+    void start (double sampleRate, int blockSize)
+    {
+        if (running.load() || std::thread::hardware_concurrency() < 2)
+            return;
+
+        state.store (idle);
+
+        auto options = juce::Thread::RealtimeOptions().withPriority (10);
+
+        if (sampleRate > 0.0 && blockSize > 0)
+            options = options.withApproximateAudioProcessingTime (blockSize, sampleRate);
+
+        // Falls back to a normal thread if realtime scheduling is refused
+        if (! startRealtimeThread (options) && ! startThread (juce::Thread::Priority::highest))
+            return;
+
+        running.store (true, std::memory_order_release);
+    }
+
+    void stop()
+    {
+        if (! running.load())
+            return;
+
+        running.store (false);
+        signalThreadShouldExit();
+        stopThread (1000);
+    }
+
+    bool isRunning() const noexcept { return running.load (std::memory_order_acquire); }
+
+    // Audio thread
+    bool isFree() const noexcept { return state.load (std::memory_order_acquire) == idle; }
+
+    void post (Job newJob, void* newContext) noexcept
+    {
+        job     = newJob;
+        context = newContext;
+        state.store (posted, std::memory_order_release);
+    }
+
+    // Audio thread: true if the worker completed the posted job (commit its
+    // result); false if the caller has to run it itself
+    bool finish (double maxWaitSeconds) noexcept
+    {
+        int expected = posted;
+
+        if (state.compare_exchange_strong (expected, idle, std::memory_order_acq_rel))
+            return false;  // worker busy or asleep: not started
+
+        using Clock = std::chrono::steady_clock;
+        const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration> (
+                                                 std::chrono::duration<double> (maxWaitSeconds));
+
+        for (int spins = 0; state.load (std::memory_order_acquire) != done; ++spins)
+        {
+            GOREKLIP_WORKER_PAUSE();
+
+            if ((spins & 63) == 63 && Clock::now() >= deadline)
+            {
+                expected = claimed;
+
+                // The worker finishes into its private copy and goes idle by itself
+                if (state.compare_exchange_strong (expected, abandoned, std::memory_order_acq_rel))
+                    return false;
+            }
+        }
+
+        state.store (idle, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    enum : int { idle = 0, posted, claimed, done, abandoned };
+
+    static constexpr double kSpinSeconds     = 0.002;
+    static constexpr int    kNapMicroseconds = 500;
+
+    void run() override
+    {
+        using Clock = std::chrono::steady_clock;
+        auto lastJob = Clock::now();
+
+        while (! threadShouldExit())
+        {
+            int expected = posted;
+
+            if (state.compare_exchange_strong (expected, claimed, std::memory_order_acq_rel))
+            {
+                job (context);
+
+                expected = claimed;
+                if (! state.compare_exchange_strong (expected, done, std::memory_order_acq_rel))
+                    state.store (idle, std::memory_order_release);  // abandoned meanwhile
+
+                lastJob = Clock::now();
+                continue;
+            }
+
+            if (std::chrono::duration<double> (Clock::now() - lastJob).count() < kSpinSeconds)
+                GOREKLIP_WORKER_PAUSE();
+            else
+                std::this_thread::sleep_for (std::chrono::microseconds (kNapMicroseconds));
+        }
+    }
+
+    std::atomic<int>  state   { idle };
+    std::atomic<bool> running { false };
+
+    Job   job     = nullptr;  // written before state = posted (release)
+    void* context = nullptr;
+};
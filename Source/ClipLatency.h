@@ -0,0 +1,140 @@
+#pragma once
+// Clip-path output history, factor-switch alignment and latency padding.
+//
+// Every oversampling factor (and filter row) has its own latency. When the
+// processor switches factors by itself – Auto below the user's factor, the
+// offline planner per region – the latency it reports must not follow, or
+// the host's delay compensation would have to move mid-playback / mid-render.
+// Instead the clip path is padded up to a fixed target:
+//
+//   target()    – largest latency over the factors that can be switched to
+//   reported()  – the target for the active factor: its own latency, or with
+//                 automatic switching up to a ceiling factor, target (0, ceiling)
+//   crossfade() – factor switch: fades from the old factor's output, delay-
+//                 aligned to the new latency, and shifts the history the same
+//                 way, so the stream continues as if the new factor had
+//                 always been running
+//   pad()       – appends a chunk to the history and delays it by
+//                 target - active latency
+//
+// With no automatic switching the target is the active latency and pad() is
+// a plain history update. Free of JUCE, so Tests/ClipLatencyTest can drive it
+// with pure-delay paths.
+//
+// prepare() allocates: message thread only.
+//
+// Provides: ClipLatency::target(), ClipLatency::reported(), ClipLatency::Aligner
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace ClipLatency {
+
+// Largest of latencies[first .. last]
+static inline int target (const int* latencies, int first, int last) noexcept
+{
+    int largest = 0;
+
+    for (int i = std::max (0, first); i <= last; ++i)
+        largest = std::max (largest, latencies[i]);
+
+    return largest;
+}
+
+// automaticCeiling < 0: the factor is the user's. Otherwise the processor may
+// run any factor up to automaticCeiling (Auto: the user's factor; offline
+// planner: the top one), so every one of them is padded to the same latency.
+static inline int reported (const int* latencies, int activeIndex, int automaticCeiling) noexcept
+{
+    return automaticCeiling >= 0 ? target (latencies, 0, automaticCeiling)
+                                 : target (latencies, activeIndex, activeIndex);
+}
+
+class Aligner
+{
+public:
+    // historyLength bounds the pad and the switch alignment (latencies < historyLength)
+    void prepare (int numChannels, int historyLength, int maxBlockSize)
+    {
+        history      = historyLength;
+        maxBlock     = std::max (1, maxBlockSize);
+        buffers.assign ((size_t) std::max (0, numChannels), std::vector<float> ((size_t) (history + maxBlock), 0.0f));
+    }
+
+    void clear() noexcept
+    {
+        for (auto& b : buffers)
+            std::fill (b.begin(), b.end(), 0.0f);
+    }
+
+    bool canProcess (int numChannels, int numSamples) const noexcept
+    {
+        return numChannels <= (int) buffers.size() && numSamples <= maxBlock;
+    }
+
+    // block: the new factor's output (latency L + delta); previous: the old
+    // factor's (latency L), both for the same input chunk
+    void crossfade (float* const* block, const float* const* previous, int numChannels, int numSamples,
+                    int delta, int fadeLength) noexcept
+    {
+        delta = std::max (-(history - 1), std::min (history - 1, delta));
+
+        // delta < 0 reads ahead, so the fade has to end |delta| before the end
+        const int fade = std::min (fadeLength, numSamples - std::max (0, -delta));
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* s          = block[ch];
+            const float* prev = previous[ch];
+            float* hist       = buffers[(size_t) ch].data();
+
+            for (int i = 0; i < fade; ++i)
+            {
+                const int   src = i - delta;
+                const float old = (src >= 0) ? prev[src] : hist[history + src];
+                s[i] = old + (s[i] - old) * ((float) (i + 1) / (float) fade);
+            }
+
+            if (delta > 0)
+            {
+                // Later by delta: older samples than the history holds repeat its first
+                std::memmove (hist + delta, hist, sizeof (float) * (size_t) (history - delta));
+                std::fill (hist, hist + delta, hist[delta]);
+            }
+            else if (delta < 0)
+            {
+                // Earlier by -delta: the old factor's output for this chunk moves into the history
+                const int ahead = std::min (-delta, numSamples);
+                std::memmove (hist, hist + ahead, sizeof (float) * (size_t) (history - ahead));
+                std::copy (prev, prev + ahead, hist + history - ahead);
+            }
+        }
+    }
+
+    // Appends the chunk to the history, then delays it by padSamples (0 .. historyLength)
+    void pad (float* const* block, int numChannels, int numSamples, int padSamples) noexcept
+    {
+        padSamples = std::max (0, std::min (history, padSamples));
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* s    = block[ch];
+            float* hist = buffers[(size_t) ch].data();
+
+            std::copy (s, s + numSamples, hist + history);
+
+            if (padSamples > 0)
+                std::copy (hist + history - padSamples, hist + history - padSamples + numSamples, s);
+
+            std::memmove (hist, hist + numSamples, sizeof (float) * (size_t) history);
+        }
+    }
+
+private:
+    std::vector<std::vector<float>> buffers;   // per channel: [history | chunk]
+    int history  = 0;
+    int maxBlock = 1;
+};
+
+} // namespace ClipLatency
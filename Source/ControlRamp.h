@@ -0,0 +1,67 @@
+#pragma once
+// Per-block control-rate coefficients with a linear ramp across the block.
+//
+// Coeffs is a plain struct of floats derived from the knobs (filter alphas,
+// gains, drive...). The processor computes it once per block and calls
+// setTarget(); the sample loop then reads at (i):
+//
+//   - knob unchanged since the last block: at (i) is the target itself, so the
+//     loop sees exactly the values it would have computed per sample.
+//   - knob moved: every field is interpolated linearly from where the previous
+//     block ended to the new target, reaching it on the last sample.
+//
+// The first setTarget() after reset() jumps straight to the target.
+
+#include <cstring>
+#include <type_traits>
+
+template <typename Coeffs>
+class ControlRamp
+{
+    static_assert (std::is_trivially_copyable<Coeffs>::value && sizeof (Coeffs) % sizeof (float) == 0,
+                   "ControlRamp coefficients must be a plain struct of floats");
+
+    static constexpr int kNumFields = (int) (sizeof (Coeffs) / sizeof (float));
+
+public:
+    void reset() noexcept { primed = false; ramping = false; }
+
+    void setTarget (const Coeffs& target, int numSamples) noexcept
+    {
+        start = primed ? end : target;
+        end   = target;
+        primed = true;
+
+        ramping   = numSamples > 1 && std::memcmp (&start, &end, sizeof (Coeffs)) != 0;
+        invLength = ramping ? 1.0f / (float) numSamples : 0.0f;
+    }
+
+    bool isRamping() const noexcept           { return ramping; }
+    const Coeffs& getStart() const noexcept   { return start; }
+    const Coeffs& getTarget() const noexcept  { return end; }
+
+    Coeffs at (int sampleIndex) const noexcept
+    {
+        if (! ramping)
+            return end;
+
+        float a[kNumFields], b[kNumFields];
+        std::memcpy (a, &start, sizeof (Coeffs));
+        std::memcpy (b, &end, sizeof (Coeffs));
+
+        const float t = (float) (sampleIndex + 1) * invLength;
+
+        for (int k = 0; k < kNumFields; ++k)
+            a[k] += t * (b[k] - a[k]);
+
+        Coeffs c;
+        std::memcpy (&c, a, sizeof (Coeffs));
+        return c;
+    }
+
+private:
+    Coeffs start {}, end {};
+    float  invLength = 0.0f;
+    bool   primed    = false;
+    bool   ramping   = false;
+};
@@ -0,0 +1,586 @@
+#pragma once
+// Low-order fit of the DSM capture EQ (DsmCaptureEq in PluginProcessor.h),
+// and the capture curve itself.
+//
+// The capture curve is 32 overlapping Q = 1 peak filters on log-spaced
+// centres. Their sum is smooth (a broad rise of ~15 dB from 20 Hz to the
+// presence region, falling off above the last band), so a handful of biquads
+// reproduce it. fit() runs at prepare: it evaluates the 32-band magnitude on
+// a log grid at the current sample rate and fits a flat gain plus
+// numSections peak / shelf biquads to it, Levenberg-Marquardt on the dB
+// error with parameters (log Hz, log Q, dB).
+//
+// The fit grid runs from 5 Hz to 0.45 sr, not just the audio band: left
+// free above 20 kHz the fit drifts there, and through the minimum-phase
+// relation that shows up as in-band phase error (a -10 dB white-noise
+// residual against the reference at 96 kHz, vs -39 dB with the full grid).
+//
+// Three starts are tried and the best kept: the 32 bands merged into
+// numSections peaks, the same with shelves at both ends, and two shelves
+// bracketing flat peaks. A single start lands in a poor local minimum at
+// some sample rates.
+//
+// coefficients() is the RBJ cookbook as juce::dsp::IIR::Coefficients
+// makeLowShelf / makePeakFilter / makeHighShelf implement it, so the target
+// is the response of the juce band filters, and filters built from
+// coefficients() have the response that was fitted. Reference and fit are
+// both minimum phase, so matching magnitude over the whole band also
+// matches phase.
+//
+// maxErrorDb is the worst |dB| difference to the reference on a dense log
+// grid from 20 Hz to min (20 kHz, 0.45 sr), with the fit's coefficients
+// rounded to float as the caller builds them; the caller compares it with its
+// tolerance and keeps the reference cascade when the fit misses.
+//
+// Provides: DsmCaptureFit::Section, Biquad, Fit, coefficients(), fit(),
+//           fitWithin(), the capture curve (kCaptureCentersHz / kCaptureGainDb,
+//           captureReference())
+
+#include <algorithm>
+#include <cmath>
+
+namespace DsmCaptureFit {
+static constexpr int kMaxSections = 6;
+static constexpr int kMaxBands    = 64;   // reference sections
+static constexpr int kFitPoints   = 96;   // log grid the fit minimises over, 5 Hz .. 0.45 sr
+static constexpr int kCheckPoints = 512;  // log grid maxErrorDb is measured on, 20 Hz .. 20 kHz
+
+enum class Shape { lowShelf, peak, highShelf };
+
+struct Section
+{
+    Shape  shape  = Shape::peak;
+    double hz     = 1000.0;
+    double q      = 1.0;
+    double gainDb = 0.0;
+};
+
+// Normalised (a0 = 1)
+struct Biquad
+{
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+};
+
+struct Fit
+{
+    double  gainDb = 0.0;   // flat gain, to fold into one section's numerator
+    Section sections[kMaxSections];
+    int     numSections = 0;
+    double  maxErrorDb  = 0.0;
+};
+
+static inline Biquad coefficients (const Section& s, double sampleRate) noexcept
+{
+    const double A     = std::pow (10.0, s.gainDb / 40.0);
+    const double omega = 2.0 * 3.14159265358979323846 * s.hz / sampleRate;
+    const double coso  = std::cos (omega);
+
+    double b0, b1, b2, a0, a1, a2;
+
+    if (s.shape == Shape::peak)
+    {
+        const double alpha = std::sin (omega) / (2.0 * s.q);
+
+        b0 = 1.0 + alpha * A;  b1 = -2.0 * coso;  b2 = 1.0 - alpha * A;
+        a0 = 1.0 + alpha / A;  a1 = -2.0 * coso;  a2 = 1.0 - alpha / A;
+    }
+    else
+    {
+        const double aminus1 = A - 1.0;
+        const double aplus1  = A + 1.0;
+        const double beta    = std::sin (omega) * std::sqrt (A) / s.q;
+        const double sign    = (s.shape == Shape::lowShelf) ? 1.0 : -1.0;  // high shelf mirrors coso
+
+        b0 = A * (aplus1 - sign * aminus1 * coso + beta);
+        b1 = A * 2.0 * (sign * aminus1 - aplus1 * coso);
+        b2 = A * (aplus1 - sign * aminus1 * coso - beta);
+        a0 = aplus1 + sign * aminus1 * coso + beta;
+        a1 = -2.0 * (sign * aminus1 + aplus1 * coso);
+        a2 = aplus1 + sign * aminus1 * coso - beta;
+    }
+
+    return { b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+}
+
+namespace detail {
+static constexpr int kMaxParams = 1 + 3 * kMaxSections;  // flat gain, then (log Hz, log Q, dB) per section
+
+// A log frequency grid with its unit-circle points, for repeated evaluation
+template <int N>
+struct Grid
+{
+    double hz[N], c1[N], s1[N], c2[N], s2[N];
+
+    Grid (double sampleRate, double lowHz, double topHz) noexcept
+    {
+        for (int k = 0; k < N; ++k)
+        {
+            hz[k] = lowHz * std::pow (topHz / lowHz, (double) k / (double) (N - 1));
+
+            const double w = 2.0 * 3.14159265358979323846 * hz[k] / sampleRate;
+            c1[k] = std::cos (w);        s1[k] = std::sin (w);
+            c2[k] = std::cos (2.0 * w);  s2[k] = std::sin (2.0 * w);
+        }
+    }
+
+    // Accumulates the section's dB response into db[]
+    void addDb (const Biquad& c, double* db) const noexcept
+    {
+        for (int k = 0; k < N; ++k)
+        {
+            const double nr = c.b0 + c.b1 * c1[k] + c.b2 * c2[k], ni = c.b1 * s1[k] + c.b2 * s2[k];
+            const double dr = 1.0  + c.a1 * c1[k] + c.a2 * c2[k], di = c.a1 * s1[k] + c.a2 * s2[k];
+            db[k] += 10.0 * std::log10 ((nr * nr + ni * ni) / (dr * dr + di * di));
+        }
+    }
+};
+
+struct Problem
+{
+    const Grid<kFitPoints>& grid;
+    const double* targetDb;
+    double sampleRate, topHz;
+    int numSections;
+
+    int numParams() const noexcept { return 1 + 3 * numSections; }
+
+    // Parameters -> fit, clamped to a well-conditioned range
+    Fit toFit (const double* p) const noexcept
+    {
+        Fit f;
+        f.numSections = numSections;
+        f.gainDb      = p[0];
+
+        for (int i = 0; i < numSections; ++i)
+        {
+            auto& s = f.sections[i];
+            s.hz     = std::min (topHz, std::max (15.0, std::exp (p[1 + 3 * i])));
+            s.q      = std::min (8.0,   std::max (0.1,  std::exp (p[2 + 3 * i])));
+            s.gainDb = std::min (30.0,  std::max (-30.0, p[3 + 3 * i]));
+        }
+
+        return f;
+    }
+
+    void fromFit (const Fit& f, double* p) const noexcept
+    {
+        p[0] = f.gainDb;
+        for (int i = 0; i < numSections; ++i)
+        {
+            p[1 + 3 * i] = std::log (f.sections[i].hz);
+            p[2 + 3 * i] = std::log (f.sections[i].q);
+            p[3 + 3 * i] = f.sections[i].gainDb;
+        }
+    }
+
+    void sectionDb (const Section& s, double* db) const noexcept
+    {
+        std::fill (db, db + kFitPoints, 0.0);
+        grid.addDb (coefficients (s, sampleRate), db);
+    }
+
+    // r = fit - target; returns sum of squares
+    double residuals (double gainDb, const double (*secDb)[kFitPoints], double* r) const noexcept
+    {
+        double sumSq = 0.0;
+
+        for (int k = 0; k < kFitPoints; ++k)
+        {
+            double db = gainDb;
+            for (int i = 0; i < numSections; ++i)
+                db += secDb[i][k];
+
+            r[k]   = db - targetDb[k];
+            sumSq += r[k] * r[k];
+        }
+
+        return sumSq;
+    }
+};
+
+// Solves a x = b in place (a: n x n, row-major), partial pivoting
+static inline bool solve (double* a, double* b, int n) noexcept
+{
+    for (int col = 0; col < n; ++col)
+    {
+        int pivot = col;
+        for (int r = col + 1; r < n; ++r)
+            if (std::abs (a[r * n + col]) > std::abs (a[pivot * n + col]))
+                pivot = r;
+
+        if (std::abs (a[pivot * n + col]) < 1.0e-300)
+            return false;
+
+        if (pivot != col)
+        {
+            for (int k = 0; k < n; ++k)
+                std::swap (a[col * n + k], a[pivot * n + k]);
+            std::swap (b[col], b[pivot]);
+        }
+
+        for (int r = col + 1; r < n; ++r)
+        {
+            const double m = a[r * n + col] / a[col * n + col];
+            for (int k = col; k < n; ++k)
+                a[r * n + k] -= m * a[col * n + k];
+            b[r] -= m * b[col];
+        }
+    }
+
+    for (int r = n - 1; r >= 0; --r)
+    {
+        double s = b[r];
+        for (int k = r + 1; k < n; ++k)
+            s -= a[r * n + k] * b[k];
+        b[r] = s / a[r * n + r];
+    }
+
+    return true;
+}
+
+// Levenberg-Marquardt from start; returns the final sum of squares
+static inline double refine (const Problem& pr, Fit& f)
+{
+    const int    n = pr.numParams();
+    const double h = 1.0e-6;
+
+    double p[kMaxParams];
+    pr.fromFit (f, p);
+    f = pr.toFit (p);
+    pr.fromFit (f, p);
+
+    double secDb[kMaxSections][kFitPoints], r[kFitPoints];
+    for (int i = 0; i < pr.numSections; ++i)
+        pr.sectionDb (f.sections[i], secDb[i]);
+
+    double cost   = pr.residuals (f.gainDb, secDb, r);
+    double lambda = 1.0e-2;
+
+    for (int iter = 0; iter < 150; ++iter)
+    {
+        // Forward-difference Jacobian; a section parameter only moves its own response
+        double jac[kMaxParams][kFitPoints];
+
+        std::fill (jac[0], jac[0] + kFitPoints, 1.0);
+
+        for (int i = 0; i < pr.numSections; ++i)
+            for (int a = 0; a < 3; ++a)
+            {
+                const int j = 1 + 3 * i + a;
+
+                double pj[kMaxParams];
+                std::copy (p, p + n, pj);
+                pj[j] += h;
+
+                double db[kFitPoints];
+                pr.sectionDb (pr.toFit (pj).sections[i], db);
+
+                for (int k = 0; k < kFitPoints; ++k)
+                    jac[j][k] = (db[k] - secDb[i][k]) / h;
+            }
+
+        double jtj[kMaxParams * kMaxParams] {}, jtr[kMaxParams] {};
+
+        for (int a = 0; a < n; ++a)
+        {
+            for (int k = 0; k < kFitPoints; ++k)
+                jtr[a] += jac[a][k] * r[k];
+
+            for (int b = a; b < n; ++b)
+            {
+                double s = 0.0;
+                for (int k = 0; k < kFitPoints; ++k)
+                    s += jac[a][k] * jac[b][k];
+                jtj[a * n + b] = jtj[b * n + a] = s;
+            }
+        }
+
+        bool improved = false;
+
+        while (! improved && lambda < 1.0e10)
+        {
+            double a[kMaxParams * kMaxParams], step[kMaxParams];
+            std::copy (jtj, jtj + n * n, a);
+
+            for (int j = 0; j < n; ++j)
+            {
+                a[j * n + j] += lambda * (jtj[j * n + j] + 1.0e-9);
+                step[j] = -jtr[j];
+            }
+
+            if (! solve (a, step, n))
+            {
+                lambda *= 10.0;
+                continue;
+            }
+
+            double pn[kMaxParams];
+            for (int j = 0; j < n; ++j)
+                pn[j] = p[j] + step[j];
+
+            const Fit trial = pr.toFit (pn);
+
+            double trialDb[kMaxSections][kFitPoints], rn[kFitPoints];
+            for (int i = 0; i < pr.numSections; ++i)
+                pr.sectionDb (trial.sections[i], trialDb[i]);
+
+            const double costN = pr.residuals (trial.gainDb, trialDb, rn);
+
+            if (costN < cost)
+            {
+                improved = true;
+                f = trial;
+                pr.fromFit (f, p);
+                std::copy (trialDb[0], trialDb[0] + kMaxSections * kFitPoints, secDb[0]);
+                std::copy (rn, rn + kFitPoints, r);
+                lambda = std::max (1.0e-9, lambda * 0.3);
+
+                const bool converged = (cost - costN) < 1.0e-9 * cost;
+                cost = costN;
+
+                if (converged)
+                    return cost;
+            }
+            else
+            {
+                lambda *= 10.0;
+            }
+        }
+
+        if (! improved)
+            break;
+    }
+
+    return cost;
+}
+} // namespace detail
+
+// reference: the numReference sections whose cascade is the target.
+// numSections: 2 .. kMaxSections biquads in the fit.
+static inline Fit fit (const Section* reference, int numReference, double sampleRate, int numSections)
+{
+    using namespace detail;
+
+    numReference = std::min (kMaxBands, numReference);
+    numSections  = std::min (kMaxSections, std::max (2, numSections));
+
+    const double topHz = 0.45 * sampleRate;
+
+    const Grid<kFitPoints> grid (sampleRate, 5.0, topHz);
+
+    double targetDb[kFitPoints] {};
+    for (int i = 0; i < numReference; ++i)
+        grid.addDb (coefficients (reference[i], sampleRate), targetDb);
+
+    const Problem pr { grid, targetDb, sampleRate, topHz, numSections };
+
+    auto targetAt = [&] (double hz)
+    {
+        int k = 0;
+        while (k < kFitPoints - 1 && grid.hz[k] < hz)
+            ++k;
+        return targetDb[k];
+    };
+
+    // Consecutive reference bands merged into one wider peak each
+    auto merged = [&] (int first, int count, int numMerged)
+    {
+        Fit f;
+        f.numSections = numMerged;
+
+        for (int m = 0; m < numMerged; ++m)
+        {
+            const int lo = first + (m * count) / numMerged;
+            const int hi = first + ((m + 1) * count) / numMerged;
+
+            double logHz = 0.0, gainDb = 0.0;
+            for (int b = lo; b < hi; ++b)
+            {
+                logHz  += std::log (reference[b].hz);
+                gainDb += reference[b].gainDb;
+            }
+
+            const double octaves = std::log2 (reference[hi - 1].hz / reference[lo].hz) + 1.4;
+            f.sections[m] = { Shape::peak, std::exp (logHz / (hi - lo)), 1.4 / octaves, gainDb };
+        }
+
+        return f;
+    };
+
+    Fit starts[3];
+
+    // 1) all peaks
+    starts[0] = merged (0, numReference, numSections);
+
+    // 2) shelves for the outer bands, peaks in between
+    {
+        const int edge = std::max (1, numReference / (2 * numSections));
+        starts[1] = merged (edge, numReference - 2 * edge, numSections);
+        starts[1].numSections = numSections;
+
+        for (int i = numSections - 1; i >= 2; --i)
+            starts[1].sections[i] = starts[1].sections[i - 2];
+
+        starts[1].sections[0] = { Shape::lowShelf,  reference[edge].hz,                    0.7, reference[0].gainDb };
+        starts[1].sections[1] = { Shape::highShelf, reference[numReference - edge - 1].hz, 0.7, reference[numReference - 1].gainDb };
+    }
+
+    // 3) flat gain, shelves for the ends, flat peaks spread in between
+    {
+        Fit& f = starts[2];
+        f.numSections = numSections;
+        f.gainDb      = targetAt (1000.0);
+        f.sections[0] = { Shape::lowShelf,  80.0,   0.7, targetAt (25.0) - f.gainDb };
+        f.sections[1] = { Shape::highShelf, 4000.0, 0.7, targetAt (topHz) - f.gainDb };
+
+        for (int i = 2; i < numSections; ++i)
+            f.sections[i] = { Shape::peak, 40.0 * std::pow (200.0, (i - 1.5) / (double) (numSections - 2)), 1.0, 0.0 };
+    }
+
+    Fit    best;
+    double bestCost = -1.0;
+
+    for (auto& start : starts)
+    {
+        const double cost = refine (pr, start);
+
+        if (bestCost < 0.0 || cost < bestCost)
+        {
+            best     = start;
+            bestCost = cost;
+        }
+    }
+
+    // Worst case on a denser grid than the fit saw
+    const Grid<kCheckPoints> check (sampleRate, 20.0, std::min (20000.0, topHz));
+
+    double refDb[kCheckPoints] {}, fitDb[kCheckPoints] {};
+
+    for (int i = 0; i < numReference; ++i)
+        check.addDb (coefficients (reference[i], sampleRate), refDb);
+
+    // The fit as the caller runs it: float coefficients, flat gain on the
+    // first numerator
+    const double flat = std::pow (10.0, best.gainDb / 20.0);
+
+    for (int i = 0; i < best.numSections; ++i)
+    {
+        const auto   c = coefficients (best.sections[i], sampleRate);
+        const double b = (i == 0) ? flat : 1.0;
+
+        check.addDb ({ (float) (b * c.b0), (float) (b * c.b1), (float) (b * c.b2), (float) c.a1, (float) c.a2 }, fitDb);
+    }
+
+    best.maxErrorDb = 0.0;
+    for (int k = 0; k < kCheckPoints; ++k)
+        best.maxErrorDb = std::max (best.maxErrorDb, std::abs (fitDb[k] - refDb[k]));
+
+    return best;
+}
+
+// The fewest sections in minSections .. maxSections whose fit is within
+// toleranceDb of the reference. When none is, the largest one comes back and
+// its maxErrorDb above toleranceDb tells the caller to keep the reference.
+static inline Fit fitWithin (const Section* reference, int numReference, double sampleRate,
+                             int minSections, int maxSections, double toleranceDb)
+{
+    Fit f;
+
+    for (int n = minSections; n <= maxSections; ++n)
+    {
+        f = fit (reference, numReference, sampleRate, n);
+
+        if (f.maxErrorDb <= toleranceDb)
+            break;
+    }
+
+    return f;
+}
+
+//==============================================================
+// The DSM capture curve: 32 Q = 1 peaks (DsmCaptureEq's reference cascade)
+//==============================================================
+static constexpr int kCaptureBands = 32;
+static_assert (kCaptureBands <= kMaxBands, "reference cascade larger than the fitter takes");
+
+// 32 log-spaced centers, 30 Hz..16 kHz
+static constexpr float kCaptureCentersHz[kCaptureBands] =
+{
+    33.092579f,
+    40.267004f,
+    48.996835f,
+    59.619282f,
+    72.544660f,
+    88.274275f,
+    107.414574f,
+    130.703420f,
+    159.041830f,
+    193.508035f,
+    235.460310f,
+    286.507782f,
+    348.616731f,
+    424.190115f,
+    516.150857f,
+    628.044838f,
+    764.213258f,
+    929.914611f,
+    1131.559314f,
+    1376.941131f,
+    1675.545405f,
+    2038.935964f,
+    2481.168518f,
+    3019.339094f,
+    3674.254166f,
+    4470.574843f,
+    5439.007361f,
+    6616.045966f,
+    8047.239269f,
+    9788.571933f,
+    11907.160373f,
+    14484.677393f
+};
+
+// Static capture curve (dB) extracted from your dry vs DSM@10% exports (Song 1+2 averaged, smoothed)
+static constexpr float kCaptureGainDb[kCaptureBands] =
+{
+    0.760310f,
+    0.000000f,
+    0.810142f,
+    0.860032f,
+    0.911617f,
+    0.987374f,
+    1.082699f,
+    1.183147f,
+    1.301452f,
+    1.465170f,
+    1.554878f,
+    1.552840f,
+    1.570643f,
+    1.567540f,
+    1.608158f,
+    1.651806f,
+    1.683060f,
+    1.750147f,
+    1.842836f,
+    1.982185f,
+    2.148078f,
+    2.376799f,
+    2.646037f,
+    2.927008f,
+    3.152581f,
+    3.302534f,
+    3.377938f,
+    3.488114f,
+    3.564036f,
+    4.178587f,
+    4.352958f,
+    4.352958f
+};
+
+static inline void captureReference (Section (&bands)[kCaptureBands]) noexcept
+{
+    for (int i = 0; i < kCaptureBands; ++i)
+        bands[i] = { Shape::peak, (double) kCaptureCentersHz[i], 1.0, (double) kCaptureGainDb[i] };
+}
+
+} // namespace DsmCaptureFit
@@ -0,0 +1,212 @@
+#pragma once
+// Antiderivative anti-aliasing (ADAA) for the DIGITAL clipper.
+//
+// Instead of f(x[n]) the clipper outputs the mean of f over the segment between
+// consecutive input samples, computed from closed-form antiderivatives:
+//
+//   1st order: y[n] = (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1])
+//   2nd order: y[n] = 2 / (x[n] - x[n-2]) * (D(x[n], x[n-1]) - D(x[n-1], x[n-2])),
+//              D(a, b) = (F2(a) - F2(b)) / (a - b)
+//
+// (Bilbao, Esqueda, Parker, Valimaki, "Antiderivative Antialiasing for
+// Memoryless Nonlinearities", IEEE SPL 2017.)
+//
+// f is the ADAA curve: identity below kKneeStart, the linearly interpolated
+// compact knee LUT above it (same as processKneeSample). F1 / F2 are its exact
+// first and second antiderivatives; the per-node values are tabulated at
+// compile time in double, so no file or runtime table build is needed.
+//
+// Side effects to be aware of:
+//   - 1st order adds half a sample of delay, 2nd order one sample.
+//   - Below the knee the output is a short FIR of the input ((x0 + x1) / 2 and
+//     (x0 + x1 + x2) / 3), i.e. a gentle top-octave rolloff at x1. Running ADAA
+//     at x2 moves that above the audio band.
+//
+// Measured (Tests/FruityMatchAdaaTest, 7 kHz sine at 44.1 kHz, x1), alias
+// energy against the harmonics: drive 1.5 goes from -29.9 dB to -39.3 (1st)
+// and -48.4 (2nd); drive 4 from -15.3 dB to -30.0 and -42.4.
+//
+// Provides: FruityMatch::AdaaState, FruityMatch::processAdaaBlock()
+
+#include "fruity_knee_lut_compact.h"
+
+namespace FruityMatch {
+namespace Adaa {
+static constexpr double kNodeStep = (double) kKneeLutStride / (double) kLutScale;
+static constexpr double kNodeX0   = (double) kKneeLutFirst / (double) kLutScale;
+static constexpr double kNodeXN   = kNodeX0 + (double) (kKneeLutSize - 1) * kNodeStep;
+static constexpr double kKnee     = (double) kKneeStart;
+
+// Below this input difference the divided differences lose precision and the
+// ill-conditioned fallbacks take over.
+static constexpr double kEps = 1.0e-5;
+
+struct NodeIntegrals
+{
+    std::array<double, kKneeLutSize> g1 {};  // integral of the knee LUT from node 0
+    std::array<double, kKneeLutSize> g2 {};  // integral of g1 from node 0
+};
+
+static constexpr NodeIntegrals makeNodeIntegrals() noexcept
+{
+    NodeIntegrals n {};
+    const double h = kNodeStep;
+
+    for (int j = 0; j < kKneeLutSize - 1; ++j)
+    {
+        const double y0 = kKneeLut[(size_t) j];
+        const double s  = ((double) kKneeLut[(size_t) j + 1] - y0) / h;
+
+        n.g1[(size_t) j + 1] = n.g1[(size_t) j] + y0 * h + s * h * h / 2.0;
+        n.g2[(size_t) j + 1] = n.g2[(size_t) j] + n.g1[(size_t) j] * h
+                             + y0 * h * h / 2.0 + s * h * h * h / 6.0;
+    }
+
+    return n;
+}
+
+static constexpr NodeIntegrals kNodes = makeNodeIntegrals();
+
+// Integrals of the knee LUT from node 0 up to u (u >= kNodeX0)
+struct KneeIntegral { double g1, g2; };
+
+static constexpr KneeIntegral kneeIntegral (double u) noexcept
+{
+    if (u >= kNodeXN)
+    {
+        // flat tail
+        const double c = kKneeLut.back();
+        const double d = u - kNodeXN;
+        const double g1 = kNodes.g1.back();
+        return { g1 + c * d, kNodes.g2.back() + g1 * d + c * d * d / 2.0 };
+    }
+
+    int j = (int) ((u - kNodeX0) / kNodeStep);
+    if (j < 0) j = 0;
+    if (j > kKneeLutSize - 2) j = kKneeLutSize - 2;
+
+    const double d  = u - (kNodeX0 + (double) j * kNodeStep);
+    const double y0 = kKneeLut[(size_t) j];
+    const double s  = ((double) kKneeLut[(size_t) j + 1] - y0) / kNodeStep;
+    const double g1 = kNodes.g1[(size_t) j];
+
+    return { g1 + y0 * d + s * d * d / 2.0,
+             kNodes.g2[(size_t) j] + g1 * d + y0 * d * d / 2.0 + s * d * d * d / 6.0 };
+}
+
+static constexpr KneeIntegral kAtKnee = kneeIntegral (kKnee);
+
+// f: odd
+static inline double curve (double x) noexcept
+{
+    return (std::fabs (x) < kKnee) ? x : (double) processKneeSample ((float) x);
+}
+
+// F1 = integral of f from 0: even
+static inline double antiderivative1 (double x) noexcept
+{
+    const double u = std::fabs (x);
+
+    if (u < kKnee)
+        return 0.5 * u * u;
+
+    return 0.5 * kKnee * kKnee + kneeIntegral (u).g1 - kAtKnee.g1;
+}
+
+// F2 = integral of F1 from 0: odd
+static inline double antiderivative2 (double x) noexcept
+{
+    const double u = std::fabs (x);
+    double v;
+
+    if (u < kKnee)
+    {
+        v = u * u * u / 6.0;
+    }
+    else
+    {
+        const double d = u - kKnee;
+        v = kKnee * kKnee * kKnee / 6.0
+          + (0.5 * kKnee * kKnee - kAtKnee.g1) * d
+          + kneeIntegral (u).g2 - kAtKnee.g2;
+    }
+
+    return (x < 0.0) ? -v : v;
+}
+} // namespace Adaa
+
+// Per-channel history. Zero-initialised state is consistent (F1(0) = F2(0) = 0).
+struct AdaaState
+{
+    double x1   = 0.0;  // x[n-1]
+    double x2   = 0.0;  // x[n-2]
+    double f1x1 = 0.0;  // F1(x[n-1])
+    double f2x1 = 0.0;  // F2(x[n-1])
+    double d1   = 0.0;  // D(x[n-1], x[n-2])
+};
+
+static inline float processAdaa1Sample (float in, AdaaState& st) noexcept
+{
+    const double x  = in;
+    const double f1 = Adaa::antiderivative1 (x);
+    const double dx = x - st.x1;
+
+    const double y = (std::fabs (dx) > Adaa::kEps) ? (f1 - st.f1x1) / dx
+                                                   : Adaa::curve (0.5 * (x + st.x1));
+
+    st.x1   = x;
+    st.f1x1 = f1;
+    return (float) y;
+}
+
+static inline float processAdaa2Sample (float in, AdaaState& st) noexcept
+{
+    const double x  = in;
+    const double f2 = Adaa::antiderivative2 (x);
+    const double dx = x - st.x1;
+
+    const double d1 = (std::fabs (dx) > Adaa::kEps) ? (f2 - st.f2x1) / dx
+                                                    : Adaa::antiderivative1 (0.5 * (x + st.x1));
+
+    const double dx2 = x - st.x2;
+    double y;
+
+    if (std::fabs (dx2) > Adaa::kEps)
+    {
+        y = 2.0 * (d1 - st.d1) / dx2;
+    }
+    else
+    {
+        // x[n] ~ x[n-2]: expand around their mean instead
+        const double xBar  = 0.5 * (x + st.x2);
+        const double delta = xBar - st.x1;
+
+        if (std::fabs (delta) > Adaa::kEps)
+            y = (2.0 / delta) * (Adaa::antiderivative1 (xBar)
+                                 + (st.f2x1 - Adaa::antiderivative2 (xBar)) / delta);
+        else
+            y = Adaa::curve (0.5 * (xBar + st.x1));
+    }
+
+    st.x2   = st.x1;
+    st.x1   = x;
+    st.f2x1 = f2;
+    st.d1   = d1;
+    return (float) y;
+}
+
+// order: 1 or 2
+static inline void processAdaaBlock (float* data, int numSamples, AdaaState& st, int order) noexcept
+{
+    if (order >= 2)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = processAdaa2Sample (data[i], st);
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = processAdaa1Sample (data[i], st);
+    }
+}
+} // namespace FruityMatch
@@ -0,0 +1,321 @@
+#pragma once
+// Block evaluation of the DIGITAL clip curve (Fruity knee + smoothstep blend).
+//
+// clipSample() is the scalar reference. processBlock() runs the same math on
+// 4 (SSE2 / NEON) or 8 (AVX2) samples at a time with no per-sample branches:
+// sign, knee test, knee evaluation and blend are all done with masks/selects.
+// The knee is either the compact LUT or the table-free polynomial (Curve).
+// Both paths use the same operation order, so they agree to within 1 ulp
+// (bit-identical unless the compiler contracts the scalar path into FMAs).
+//
+// Provides: FruityMatch::clipSample<Curve>(float), FruityMatch::processBlock(float*, int, Curve)
+
+#include "FruityMatchPoly.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined (__AVX2__)
+ #include <immintrin.h>
+ #define FRUITYMATCH_AVX2 1
+#elif defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define FRUITYMATCH_SSE2 1
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+ #include <arm_neon.h>
+ #define FRUITYMATCH_NEON 1
+#endif
+
+namespace FruityMatch {
+static constexpr float kBlendWidth = 0.00035f;  // MUCH tighter blend
+static constexpr float kBlendEnd   = kKneeStart + kBlendWidth;
+
+// Lanes below the knee are clamped to entry 0 of kKneeLut, so their
+// (discarded) loads stay inside the ~5 KB compact table.
+static constexpr float kKneeLutMax = (float) (kKneeLutSize - 1);
+
+// How the knee itself is evaluated (see FruityMatchPoly.h for the error bound)
+enum class Curve
+{
+    kneeLut = 0,   // compact LUT, linear interpolation
+    polynomial     // piecewise minimax polynomials, no table
+};
+
+template <Curve curve = Curve::kneeLut>
+static inline float clipSample (float x) noexcept
+{
+    const float ax = std::fabs (x);
+
+    if (ax <= kKneeStart)
+        return x;
+
+    float y = (curve == Curve::polynomial) ? processPolySample (x)
+                                           : processKneeSample (x);
+
+    if (ax < kBlendEnd)
+    {
+        float t = (ax - kKneeStart) / kBlendWidth;
+        t = std::min (1.0f, std::max (0.0f, t));
+        t = t * t * (3.0f - 2.0f * t); // smoothstep
+        y = x + (y - x) * t;
+    }
+
+    return y;
+}
+
+#if FRUITYMATCH_AVX2
+static inline __m256 kneeLut8 (__m256 ax) noexcept
+{
+    // LUT lookup: t clamped to the last entry reproduces the kXMax saturation
+    __m256 t   = _mm256_min_ps (_mm256_mul_ps (ax, _mm256_set1_ps (kLutScale)),
+                                _mm256_set1_ps ((float) (kLutSize - 1)));
+    t          = _mm256_mul_ps (_mm256_sub_ps (t, _mm256_set1_ps ((float) kKneeLutFirst)),
+                                _mm256_set1_ps (1.0f / (float) kKneeLutStride));
+    t          = _mm256_min_ps (t, _mm256_set1_ps (kKneeLutMax));
+    __m256i i0 = _mm256_cvttps_epi32 (t);
+    i0         = _mm256_min_epi32 (i0, _mm256_set1_epi32 (kKneeLutSize - 2));
+    i0         = _mm256_max_epi32 (i0, _mm256_setzero_si256());
+    const __m256 fr = _mm256_sub_ps (t, _mm256_cvtepi32_ps (i0));
+
+    const float* lut = kKneeLut.data();
+    const __m256 y0  = _mm256_i32gather_ps (lut, i0, 4);
+    const __m256 y1  = _mm256_i32gather_ps (lut + 1, i0, 4);
+    return _mm256_add_ps (y0, _mm256_mul_ps (_mm256_sub_ps (y1, y0), fr));
+}
+
+static inline __m256 kneePoly8 (__m256 ax) noexcept
+{
+    static_assert (kPolySegments == 4, "permutevar selects among 4 segments");
+
+    __m256 v = _mm256_mul_ps (_mm256_sub_ps (ax, _mm256_set1_ps (kPolyXMin)), _mm256_set1_ps (kPolyScale));
+    v        = _mm256_max_ps (v, _mm256_setzero_ps());
+    __m256i seg = _mm256_min_epi32 (_mm256_cvttps_epi32 (v), _mm256_set1_epi32 (kPolySegments - 1));
+    const __m256 u = _mm256_sub_ps (_mm256_mul_ps (_mm256_set1_ps (2.0f), _mm256_sub_ps (v, _mm256_cvtepi32_ps (seg))),
+                                    _mm256_set1_ps (1.0f));
+
+    auto coeff = [seg] (int p) noexcept
+    {
+        const __m256 c = _mm256_setr_ps (kPolyCoeffs[0][p], kPolyCoeffs[1][p], kPolyCoeffs[2][p], kPolyCoeffs[3][p],
+                                         kPolyCoeffs[0][p], kPolyCoeffs[1][p], kPolyCoeffs[2][p], kPolyCoeffs[3][p]);
+        return _mm256_permutevar_ps (c, seg);
+    };
+
+    __m256 y = coeff (kPolyOrder);
+    for (int p = kPolyOrder - 1; p >= 0; --p)
+        y = _mm256_add_ps (_mm256_mul_ps (y, u), coeff (p));
+
+    const __m256 flat = _mm256_cmp_ps (ax, _mm256_set1_ps (kPolyXMax), _CMP_GE_OQ);
+    return _mm256_blendv_ps (y, _mm256_set1_ps (kFullRangeLut.back()), flat);
+}
+
+template <Curve curve>
+static inline __m256 clip8 (__m256 x) noexcept
+{
+    const __m256 signMask = _mm256_set1_ps (-0.0f);
+    const __m256 ax       = _mm256_andnot_ps (signMask, x);
+    const __m256 sign     = _mm256_and_ps (signMask, x);
+
+    __m256 y = (curve == Curve::polynomial) ? kneePoly8 (ax) : kneeLut8 (ax);
+    y        = _mm256_or_ps (y, sign);
+
+    // smoothstep blend across [kKneeStart, kBlendEnd)
+    __m256 u = _mm256_div_ps (_mm256_sub_ps (ax, _mm256_set1_ps (kKneeStart)), _mm256_set1_ps (kBlendWidth));
+    u        = _mm256_min_ps (_mm256_set1_ps (1.0f), _mm256_max_ps (_mm256_setzero_ps(), u));
+    u        = _mm256_mul_ps (_mm256_mul_ps (u, u), _mm256_sub_ps (_mm256_set1_ps (3.0f), _mm256_add_ps (u, u)));
+    const __m256 yb = _mm256_add_ps (x, _mm256_mul_ps (_mm256_sub_ps (y, x), u));
+
+    const __m256 inBlend = _mm256_cmp_ps (ax, _mm256_set1_ps (kBlendEnd), _CMP_LT_OQ);
+    const __m256 inKnee  = _mm256_cmp_ps (ax, _mm256_set1_ps (kKneeStart), _CMP_GT_OQ);
+
+    y = _mm256_blendv_ps (y, yb, inBlend);
+    return _mm256_blendv_ps (x, y, inKnee);
+}
+#endif
+
+#if FRUITYMATCH_SSE2
+static inline __m128 select4 (__m128 mask, __m128 a, __m128 b) noexcept
+{
+    return _mm_or_ps (_mm_and_ps (mask, a), _mm_andnot_ps (mask, b));
+}
+
+static inline __m128 kneeLut4 (__m128 ax) noexcept
+{
+    __m128 t = _mm_min_ps (_mm_mul_ps (ax, _mm_set1_ps (kLutScale)),
+                           _mm_set1_ps ((float) (kLutSize - 1)));
+    t        = _mm_mul_ps (_mm_sub_ps (t, _mm_set1_ps ((float) kKneeLutFirst)),
+                           _mm_set1_ps (1.0f / (float) kKneeLutStride));
+    t        = _mm_min_ps (t, _mm_set1_ps (kKneeLutMax));
+
+    // SSE2 has no integer min/max: clamp in float, then truncate
+    const __m128 tc = _mm_max_ps (_mm_min_ps (t, _mm_set1_ps ((float) (kKneeLutSize - 2))),
+                                  _mm_setzero_ps());
+    const __m128i i0 = _mm_cvttps_epi32 (tc);
+    const __m128  fr = _mm_sub_ps (t, _mm_cvtepi32_ps (i0));
+
+    alignas (16) int32_t idx[4];
+    _mm_store_si128 ((__m128i*) idx, i0);
+
+    // y0/y1 are adjacent, so fetch each pair with one 64-bit load and de-interleave
+    const float* lut = kKneeLut.data();
+    __m128 p01 = _mm_loadl_pi (_mm_setzero_ps(), (const __m64*) (lut + idx[0]));
+    p01        = _mm_loadh_pi (p01, (const __m64*) (lut + idx[1]));
+    __m128 p23 = _mm_loadl_pi (_mm_setzero_ps(), (const __m64*) (lut + idx[2]));
+    p23        = _mm_loadh_pi (p23, (const __m64*) (lut + idx[3]));
+
+    const __m128 y0 = _mm_shuffle_ps (p01, p23, _MM_SHUFFLE (2, 0, 2, 0));
+    const __m128 y1 = _mm_shuffle_ps (p01, p23, _MM_SHUFFLE (3, 1, 3, 1));
+
+    return _mm_add_ps (y0, _mm_mul_ps (_mm_sub_ps (y1, y0), fr));
+}
+
+static inline __m128 kneePoly4 (__m128 ax) noexcept
+{
+    __m128 v = _mm_mul_ps (_mm_sub_ps (ax, _mm_set1_ps (kPolyXMin)), _mm_set1_ps (kPolyScale));
+    v        = _mm_max_ps (v, _mm_setzero_ps());
+    const __m128 segF = _mm_cvtepi32_ps (_mm_cvttps_epi32 (_mm_min_ps (v, _mm_set1_ps ((float) (kPolySegments - 1)))));
+    const __m128 u    = _mm_sub_ps (_mm_mul_ps (_mm_set1_ps (2.0f), _mm_sub_ps (v, segF)), _mm_set1_ps (1.0f));
+
+    // Segment select by masks (no shuffle-by-index on SSE2)
+    __m128 atLeast[kPolySegments];
+    for (int sgi = 1; sgi < kPolySegments; ++sgi)
+        atLeast[sgi] = _mm_cmpge_ps (segF, _mm_set1_ps ((float) sgi));
+
+    auto coeff = [&atLeast] (int p) noexcept
+    {
+        __m128 c = _mm_set1_ps (kPolyCoeffs[0][p]);
+        for (int sgi = 1; sgi < kPolySegments; ++sgi)
+            c = select4 (atLeast[sgi], _mm_set1_ps (kPolyCoeffs[sgi][p]), c);
+        return c;
+    };
+
+    __m128 y = coeff (kPolyOrder);
+    for (int p = kPolyOrder - 1; p >= 0; --p)
+        y = _mm_add_ps (_mm_mul_ps (y, u), coeff (p));
+
+    const __m128 flat = _mm_cmpge_ps (ax, _mm_set1_ps (kPolyXMax));
+    return select4 (flat, _mm_set1_ps (kFullRangeLut.back()), y);
+}
+
+template <Curve curve>
+static inline __m128 clip4 (__m128 x) noexcept
+{
+    const __m128 signMask = _mm_set1_ps (-0.0f);
+    const __m128 ax       = _mm_andnot_ps (signMask, x);
+    const __m128 sign     = _mm_and_ps (signMask, x);
+
+    __m128 y = (curve == Curve::polynomial) ? kneePoly4 (ax) : kneeLut4 (ax);
+    y        = _mm_or_ps (y, sign);
+
+    __m128 u = _mm_div_ps (_mm_sub_ps (ax, _mm_set1_ps (kKneeStart)), _mm_set1_ps (kBlendWidth));
+    u        = _mm_min_ps (_mm_set1_ps (1.0f), _mm_max_ps (_mm_setzero_ps(), u));
+    u        = _mm_mul_ps (_mm_mul_ps (u, u), _mm_sub_ps (_mm_set1_ps (3.0f), _mm_add_ps (u, u)));
+    const __m128 yb = _mm_add_ps (x, _mm_mul_ps (_mm_sub_ps (y, x), u));
+
+    const __m128 inBlend = _mm_cmplt_ps (ax, _mm_set1_ps (kBlendEnd));
+    const __m128 inKnee  = _mm_cmpgt_ps (ax, _mm_set1_ps (kKneeStart));
+
+    y = select4 (inBlend, yb, y);
+    return select4 (inKnee, y, x);
+}
+#endif
+
+#if FRUITYMATCH_NEON
+static inline float32x4_t kneeLut4 (float32x4_t ax) noexcept
+{
+    float32x4_t t = vminq_f32 (vmulq_n_f32 (ax, kLutScale), vdupq_n_f32 ((float) (kLutSize - 1)));
+    t             = vmulq_n_f32 (vsubq_f32 (t, vdupq_n_f32 ((float) kKneeLutFirst)), 1.0f / (float) kKneeLutStride);
+    t             = vminq_f32 (t, vdupq_n_f32 (kKneeLutMax));
+    int32x4_t i0  = vcvtq_s32_f32 (t);
+    i0            = vminq_s32 (i0, vdupq_n_s32 (kKneeLutSize - 2));
+    i0            = vmaxq_s32 (i0, vdupq_n_s32 (0));
+    const float32x4_t fr = vsubq_f32 (t, vcvtq_f32_s32 (i0));
+
+    const float* lut = kKneeLut.data();
+    const float32x4_t p01 = vcombine_f32 (vld1_f32 (lut + vgetq_lane_s32 (i0, 0)),
+                                          vld1_f32 (lut + vgetq_lane_s32 (i0, 1)));
+    const float32x4_t p23 = vcombine_f32 (vld1_f32 (lut + vgetq_lane_s32 (i0, 2)),
+                                          vld1_f32 (lut + vgetq_lane_s32 (i0, 3)));
+    const float32x4x2_t yy = vuzpq_f32 (p01, p23); // val[0] = y0, val[1] = y1
+
+    return vaddq_f32 (yy.val[0], vmulq_f32 (vsubq_f32 (yy.val[1], yy.val[0]), fr));
+}
+
+static inline float32x4_t kneePoly4 (float32x4_t ax) noexcept
+{
+    float32x4_t v = vmulq_n_f32 (vsubq_f32 (ax, vdupq_n_f32 (kPolyXMin)), kPolyScale);
+    v             = vmaxq_f32 (v, vdupq_n_f32 (0.0f));
+    const int32x4_t   seg  = vminq_s32 (vcvtq_s32_f32 (v), vdupq_n_s32 (kPolySegments - 1));
+    const float32x4_t segF = vcvtq_f32_s32 (seg);
+    const float32x4_t u    = vsubq_f32 (vmulq_n_f32 (vsubq_f32 (v, segF), 2.0f), vdupq_n_f32 (1.0f));
+
+    auto coeff = [seg] (int p) noexcept
+    {
+        float32x4_t c = vdupq_n_f32 (kPolyCoeffs[0][p]);
+        for (int sgi = 1; sgi < kPolySegments; ++sgi)
+            c = vbslq_f32 (vcgeq_s32 (seg, vdupq_n_s32 (sgi)), vdupq_n_f32 (kPolyCoeffs[sgi][p]), c);
+        return c;
+    };
+
+    float32x4_t y = coeff (kPolyOrder);
+    for (int p = kPolyOrder - 1; p >= 0; --p)
+        y = vaddq_f32 (vmulq_f32 (y, u), coeff (p));
+
+    return vbslq_f32 (vcgeq_f32 (ax, vdupq_n_f32 (kPolyXMax)), vdupq_n_f32 (kFullRangeLut.back()), y);
+}
+
+template <Curve curve>
+static inline float32x4_t clip4 (float32x4_t x) noexcept
+{
+    const float32x4_t ax = vabsq_f32 (x);
+    const uint32x4_t sign = vandq_u32 (vreinterpretq_u32_f32 (x), vdupq_n_u32 (0x80000000u));
+
+    float32x4_t y = (curve == Curve::polynomial) ? kneePoly4 (ax) : kneeLut4 (ax);
+    y             = vreinterpretq_f32_u32 (vorrq_u32 (vreinterpretq_u32_f32 (y), sign));
+
+    float32x4_t u = vsubq_f32 (ax, vdupq_n_f32 (kKneeStart));
+   #if defined (__aarch64__) || defined (_M_ARM64)
+    u             = vdivq_f32 (u, vdupq_n_f32 (kBlendWidth));
+   #else
+    u             = vmulq_n_f32 (u, 1.0f / kBlendWidth); // no vector divide on ARMv7
+   #endif
+    u             = vminq_f32 (vdupq_n_f32 (1.0f), vmaxq_f32 (vdupq_n_f32 (0.0f), u));
+    u             = vmulq_f32 (vmulq_f32 (u, u), vsubq_f32 (vdupq_n_f32 (3.0f), vaddq_f32 (u, u)));
+    const float32x4_t yb = vaddq_f32 (x, vmulq_f32 (vsubq_f32 (y, x), u));
+
+    const uint32x4_t inBlend = vcltq_f32 (ax, vdupq_n_f32 (kBlendEnd));
+    const uint32x4_t inKnee  = vcgtq_f32 (ax, vdupq_n_f32 (kKneeStart));
+
+    y = vbslq_f32 (inBlend, yb, y);
+    return vbslq_f32 (inKnee, y, x);
+}
+#endif
+
+template <Curve curve>
+static inline void processBlockImpl (float* data, int numSamples) noexcept
+{
+    int i = 0;
+
+   #if FRUITYMATCH_AVX2
+    for (; i + 8 <= numSamples; i += 8)
+        _mm256_storeu_ps (data + i, clip8<curve> (_mm256_loadu_ps (data + i)));
+   #elif FRUITYMATCH_SSE2
+    for (; i + 4 <= numSamples; i += 4)
+        _mm_storeu_ps (data + i, clip4<curve> (_mm_loadu_ps (data + i)));
+   #elif FRUITYMATCH_NEON
+    for (; i + 4 <= numSamples; i += 4)
+        vst1q_f32 (data + i, clip4<curve> (vld1q_f32 (data + i)));
+   #endif
+
+    for (; i < numSamples; ++i)
+        data[i] = clipSample<curve> (data[i]);
+}
+
+// In-place DIGITAL clip of a contiguous block.
+static inline void processBlock (float* data, int numSamples, Curve curve = Curve::kneeLut) noexcept
+{
+    if (curve == Curve::polynomial)
+        processBlockImpl<Curve::polynomial> (data, numSamples);
+    else
+        processBlockImpl<Curve::kneeLut> (data, numSamples);
+}
+} // namespace FruityMatch
@@ -0,0 +1,62 @@
+#pragma once
+// Oversampler interface used by the clip path.
+//
+// The processor only needs up / down over a block, reset and latency, so every
+// engine in the bank hides behind this. Implementations:
+//   JuceOversamplingEngine    – wraps juce::dsp::Oversampling (any filter type)
+//   StereoHalfbandOversampler – SIMD halfband cascade for mono / stereo
+//                               (StereoHalfbandOversampler.h, HalfbandCascade.h)
+//
+// Contract (same as juce::dsp::Oversampling):
+//   - initProcessing() allocates; everything else is audio-thread safe.
+//   - processSamplesUp() returns a block owned by the engine, valid until the
+//     matching processSamplesDown().
+//   - getLatencyInSamples() is in base-rate samples.
+
+#include "JuceHeader.h"
+#include "HalfbandCascade.h"   // OversamplingQuality tiers, getHalfbandStageSpec
+
+#include <algorithm>
+#include <memory>
+
+//==============================================================
+class OversamplingEngine
+{
+public:
+    virtual ~OversamplingEngine() = default;
+
+    virtual void initProcessing (size_t maxSamplesPerBlock) = 0;
+    virtual void reset() noexcept = 0;
+
+    virtual juce::dsp::AudioBlock<float> processSamplesUp (const juce::dsp::AudioBlock<const float>& input) noexcept = 0;
+    virtual void processSamplesDown (juce::dsp::AudioBlock<float>& output) noexcept = 0;
+
+    virtual float  getLatencyInSamples() const noexcept = 0;
+    virtual size_t getOversamplingFactor() const noexcept = 0;
+};
+
+class JuceOversamplingEngine : public OversamplingEngine
+{
+public:
+    explicit JuceOversamplingEngine (std::unique_ptr<juce::dsp::Oversampling<float>> os)
+        : oversampling (std::move (os)) {}
+
+    void initProcessing (size_t maxSamplesPerBlock) override { oversampling->initProcessing (maxSamplesPerBlock); }
+    void reset() noexcept override                            { oversampling->reset(); }
+
+    juce::dsp::AudioBlock<float> processSamplesUp (const juce::dsp::AudioBlock<const float>& input) noexcept override
+    {
+        return oversampling->processSamplesUp (input);
+    }
+
+    void processSamplesDown (juce::dsp::AudioBlock<float>& output) noexcept override
+    {
+        oversampling->processSamplesDown (output);
+    }
+
+    float  getLatencyInSamples() const noexcept override    { return oversampling->getLatencyInSamples(); }
+    size_t getOversamplingFactor() const noexcept override  { return oversampling->getOversamplingFactor(); }
+
+private:
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversampling;
+};
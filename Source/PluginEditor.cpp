@@ -24,7 +24,8 @@ private:
     juce::String text;
 };
 
-class OversampleSettingsComponent : public juce::Component
+class OversampleSettingsComponent : public juce::Component,
+                                    private juce::Timer
 {
 public:
     OversampleSettingsComponent (FruityClipAudioProcessor& proc,
@@ -69,6 +70,10 @@ public:
             offlineCombo.addItem (modes[i], id);
         }
 
+        // Per-region planner at an alias target: ids 9, 10 => stored 7, 8
+        offlineCombo.addItem ("PLAN -60 DB", FruityClipAudioProcessor::kOfflinePlanFirst + 2);
+        offlineCombo.addItem ("PLAN -80 DB", FruityClipAudioProcessor::kOfflinePlanFirst + 3);
+
         // Combo appearance – black background, white text
         auto setupCombo = [] (juce::ComboBox& c)
         {
@@ -115,7 +120,7 @@ public:
 
         // OFFLINE column stored in userSettings
         {
-            const int offlineIndex = processor.getStoredOfflineOversampleIndex(); // -1..6
+            const int offlineIndex = processor.getStoredOfflineOversampleIndex(); // -1..8
 
             if (offlineIndex < 0)
             {
@@ -124,7 +129,7 @@ public:
             }
             else
             {
-                // 0..6 map to ids 2..8
+                // 0..8 map to ids 2..10
                 offlineCombo.setSelectedId (offlineIndex + 2, juce::dontSendNotification);
             }
 
@@ -139,13 +144,105 @@ public:
                 }
                 else
                 {
-                    // explicit oversample index: id 2..8 => 0..6
-                    const int idx = juce::jlimit (0, 6, selectedId - 2);
+                    // explicit oversample index / planner: id 2..10 => 0..8
+                    const int idx = juce::jlimit (0, FruityClipAudioProcessor::kOfflineIndexLast, selectedId - 2);
                     processor.setStoredOfflineOversampleIndex (idx);
                 }
             };
         }
 
+        // TARGET row: factor from a target internal rate, bound to "osTargetRate" (0 = off)
+        targetLabel.setText ("TARGET RATE", juce::dontSendNotification);
+        targetLabel.setJustificationType (juce::Justification::centred);
+        targetLabel.setColour (juce::Label::textColourId, juce::Colours::white);
+        addAndMakeVisible (targetLabel);
+
+        targetCombo.addItem ("OFF",       1);
+        targetCombo.addItem ("176.4 KHZ", 2);
+        targetCombo.addItem ("352.8 KHZ", 3);
+        targetCombo.addItem ("705.6 KHZ", 4);
+        targetCombo.addItem ("1.41 MHZ",  5);
+        setupCombo (targetCombo);
+        addAndMakeVisible (targetCombo);
+
+        targetAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment> (
+            parameters, "osTargetRate", targetCombo);
+
+        // AUTO row: realtime factor follows the CPU budget, bound to "osAuto"
+        autoLabel.setText ("AUTO", juce::dontSendNotification);
+        autoLabel.setJustificationType (juce::Justification::centred);
+        autoLabel.setColour (juce::Label::textColourId, juce::Colours::white);
+        addAndMakeVisible (autoLabel);
+
+        autoCombo.addItem ("OFF", 1);
+        autoCombo.addItem ("ON",  2);
+        setupCombo (autoCombo);
+        addAndMakeVisible (autoCombo);
+
+        autoAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment> (
+            parameters, "osAuto", autoCombo);
+
+        // ALIAS row: clipper ADAA (DIGITAL 1st / 2nd order, ANALOG 1st), bound to "adaaMode" (0..2)
+        aliasLabel.setText ("ANTI-ALIAS", juce::dontSendNotification);
+        aliasLabel.setJustificationType (juce::Justification::centred);
+        aliasLabel.setColour (juce::Label::textColourId, juce::Colours::white);
+        addAndMakeVisible (aliasLabel);
+
+        aliasCombo.addItem ("OFF",    1);
+        aliasCombo.addItem ("ADAA 1", 2);
+        aliasCombo.addItem ("ADAA 2", 3);
+        setupCombo (aliasCombo);
+        addAndMakeVisible (aliasCombo);
+
+        aliasAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment> (
+            parameters, "adaaMode", aliasCombo);
+
+        // QUALITY row: oversampling halfband filter tier, bound to "osQuality" (0..2)
+        qualityLabel.setText ("QUALITY", juce::dontSendNotification);
+        qualityLabel.setJustificationType (juce::Justification::centred);
+        qualityLabel.setColour (juce::Label::textColourId, juce::Colours::white);
+        addAndMakeVisible (qualityLabel);
+
+        qualityCombo.addItem ("ECO",      1);
+        qualityCombo.addItem ("BALANCED", 2);
+        qualityCombo.addItem ("MAX",      3);
+        setupCombo (qualityCombo);
+        addAndMakeVisible (qualityCombo);
+
+        qualityAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment> (
+            parameters, "osQuality", qualityCombo);
+
+        // PHASE row: IIR (minimum phase) or linear-phase FIR filters, bound to "osLinearPhase"
+        phaseLabel.setText ("PHASE", juce::dontSendNotification);
+        phaseLabel.setJustificationType (juce::Justification::centred);
+        phaseLabel.setColour (juce::Label::textColourId, juce::Colours::white);
+        addAndMakeVisible (phaseLabel);
+
+        phaseCombo.addItem ("MINIMUM", 1);
+        phaseCombo.addItem ("LINEAR",  2);
+        setupCombo (phaseCombo);
+        addAndMakeVisible (phaseCombo);
+
+        phaseAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment> (
+            parameters, "osLinearPhase", phaseCombo);
+
+        // CEILING row: true-peak ceiling, bound to "tpCeiling" (0 = off)
+        ceilingLabel.setText ("TP CEILING", juce::dontSendNotification);
+        ceilingLabel.setJustificationType (juce::Justification::centred);
+        ceilingLabel.setColour (juce::Label::textColourId, juce::Colours::white);
+        addAndMakeVisible (ceilingLabel);
+
+        ceilingCombo.addItem ("OFF",       1);
+        ceilingCombo.addItem ("0.0 dBTP",  2);
+        ceilingCombo.addItem ("-0.3 dBTP", 3);
+        ceilingCombo.addItem ("-1.0 dBTP", 4);
+        ceilingCombo.addItem ("-2.0 dBTP", 5);
+        setupCombo (ceilingCombo);
+        addAndMakeVisible (ceilingCombo);
+
+        ceilingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment> (
+            parameters, "tpCeiling", ceilingCombo);
+
         // Info label: no longer showing CPU warning text, keep it simple and ASCII-safe
         infoLabel.setText ({}, juce::dontSendNotification);
         infoLabel.setColour (juce::Label::textColourId, juce::Colours::white.withAlpha (0.85f));
@@ -155,6 +252,10 @@ public:
 
         addAndMakeVisible (infoLabel);
 
+        // Info line shows the sparse-oversampling duty cycle
+        timerCallback();
+        startTimerHz (4);
+
         // Make sure popup menus for these combos are also black/white
         if (auto* lf = dynamic_cast<juce::LookAndFeel_V4*> (&getLookAndFeel()))
         {
@@ -204,6 +305,48 @@ public:
         liveCombo.setBounds    (liveArea);
         offlineCombo.setBounds (offArea);
 
+        r.removeFromTop (8);
+
+        // TARGET RATE row: label | combo
+        auto targetRow = r.removeFromTop (26);
+        targetLabel.setBounds (targetRow.removeFromLeft (halfWidth));
+        targetCombo.setBounds (targetRow.reduced (0, 2));
+
+        r.removeFromTop (4);
+
+        // AUTO row: label | combo
+        auto autoRow = r.removeFromTop (26);
+        autoLabel.setBounds (autoRow.removeFromLeft (halfWidth));
+        autoCombo.setBounds (autoRow.reduced (0, 2));
+
+        r.removeFromTop (4);
+
+        // ANTI-ALIAS row: label | combo
+        auto aliasRow = r.removeFromTop (26);
+        aliasLabel.setBounds (aliasRow.removeFromLeft (halfWidth));
+        aliasCombo.setBounds (aliasRow.reduced (0, 2));
+
+        r.removeFromTop (4);
+
+        // QUALITY row: label | combo
+        auto qualityRow = r.removeFromTop (26);
+        qualityLabel.setBounds (qualityRow.removeFromLeft (halfWidth));
+        qualityCombo.setBounds (qualityRow.reduced (0, 2));
+
+        r.removeFromTop (4);
+
+        // PHASE row: label | combo
+        auto phaseRow = r.removeFromTop (26);
+        phaseLabel.setBounds (phaseRow.removeFromLeft (halfWidth));
+        phaseCombo.setBounds (phaseRow.reduced (0, 2));
+
+        r.removeFromTop (4);
+
+        // TP CEILING row: label | combo
+        auto ceilingRow = r.removeFromTop (26);
+        ceilingLabel.setBounds (ceilingRow.removeFromLeft (halfWidth));
+        ceilingCombo.setBounds (ceilingRow.reduced (0, 2));
+
         r.removeFromTop (10);
 
         // Info label takes the remaining area
@@ -222,6 +365,17 @@ public:
     }
 
 private:
+    void timerCallback() override
+    {
+        // Factor in use (AUTO may run below LIVE) and the share of the clip
+        // stage that actually ran through the oversampler
+        const int activeFactor = 1 << juce::jlimit (0, 6, processor.getActiveOversampleIndex());
+        const int dutyPercent  = juce::roundToInt (processor.getOversampleDutyCycle() * 100.0f);
+        infoLabel.setText ("ACTIVE: x" + juce::String (activeFactor)
+                           + "   OS DUTY: " + juce::String (dutyPercent) + "%",
+                           juce::dontSendNotification);
+    }
+
     FruityClipAudioProcessor& processor;
     juce::AudioProcessorValueTreeState& parameters;
 
@@ -230,10 +384,28 @@ private:
     juce::Label     offlineLabel;
     juce::ComboBox  liveCombo;
     juce::ComboBox  offlineCombo;
+    juce::Label     targetLabel;
+    juce::ComboBox  targetCombo;
+    juce::Label     autoLabel;
+    juce::ComboBox  autoCombo;
+    juce::Label     aliasLabel;
+    juce::ComboBox  aliasCombo;
+    juce::Label     qualityLabel;
+    juce::ComboBox  qualityCombo;
+    juce::Label     phaseLabel;
+    juce::ComboBox  phaseCombo;
+    juce::Label     ceilingLabel;
+    juce::ComboBox  ceilingCombo;
 
     juce::Label infoLabel;
 
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> liveAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> targetAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> autoAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> aliasAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> qualityAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> phaseAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> ceilingAttachment;
 };
 }
 
@@ -1066,7 +1238,7 @@ void FruityClipAudioProcessorEditor::showOversampleMenu()
 
     content->syncLiveFromIndex (currentIndex);
 
-    content->setSize (320, 120);
+    content->setSize (320, 326);
 
     juce::DialogWindow::LaunchOptions options;
     options.dialogTitle              = "OVERSAMPLING";
@@ -1212,6 +1384,10 @@ void FruityClipAudioProcessorEditor::showSettingsMenu()
     constexpr int idModeAnalog     = 5;
     constexpr int idOversampleMenu = 6;
     constexpr int idKlipBible      = 7;
+    constexpr int idCurveLut       = 8;
+    constexpr int idCurvePoly      = 9;
+    constexpr int idMultiCore      = 10;
+    constexpr int idAnalogModel    = 11; // + model index
 
     // LOOK modes – mutually exclusive, ticked based on current mode
     menu.addItem (idLookCooked,
@@ -1244,6 +1420,31 @@ void FruityClipAudioProcessorEditor::showSettingsMenu()
                   true,
                   clipMode == FruityClipAudioProcessor::ClipMode::Analog);
 
+    // DIGITAL knee evaluator (global preference, same sound within ~-114 dBFS)
+    const int digitalCurve = processor.getStoredDigitalCurve();
+
+    menu.addItem (idCurveLut,
+                  "CURVE – LUT",
+                  true,
+                  digitalCurve == 0);
+
+    menu.addItem (idCurvePoly,
+                  "CURVE – POLY",
+                  true,
+                  digitalCurve == 1);
+
+    // ANALOG model (session parameter, last pick is the default for new
+    // instances); Tests/AnalogEngineBench compares their cost
+    const int analogModel = processor.getAnalogModel();
+
+    for (int model = 0; model < (int) AnalogEngine::Model::numModels; ++model)
+    {
+        menu.addItem (idAnalogModel + model,
+                      juce::String ("ANALOG – ") + AnalogEngine::kVariants[model].name,
+                      true,
+                      analogModel == model);
+    }
+
     // Separator between MODE and OVERSAMPLE
     menu.addSeparator();
 
@@ -1252,6 +1453,12 @@ void FruityClipAudioProcessorEditor::showSettingsMenu()
                   "OVERSAMPLE",
                   true);
 
+    // Second channel of the x32 / x64 clip stage on a worker core (global preference)
+    menu.addItem (idMultiCore,
+                  "OVERSAMPLE – MULTI-CORE",
+                  true,
+                  processor.getStoredMultiCore());
+
     // Separator line before KLIPERBIBLE
     menu.addSeparator();
 
@@ -1291,6 +1498,18 @@ void FruityClipAudioProcessorEditor::showSettingsMenu()
                                         clipModeParam->setValueNotifyingHost (1.0f);
                                     break;
 
+                                case idCurveLut:
+                                    processor.setStoredDigitalCurve (0);
+                                    break;
+
+                                case idCurvePoly:
+                                    processor.setStoredDigitalCurve (1);
+                                    break;
+
+                                case idMultiCore:
+                                    processor.setStoredMultiCore (! processor.getStoredMultiCore());
+                                    break;
+
                                 case idOversampleMenu:
                                     // Open the oversample settings window (LIVE/OFFLINE/SAME)
                                     showOversampleMenu();
@@ -1301,7 +1520,9 @@ void FruityClipAudioProcessorEditor::showSettingsMenu()
                                     break;
 
                                 default:
-                                    break; // user cancelled
+                                    if (result >= idAnalogModel && result < idAnalogModel + (int) AnalogEngine::Model::numModels)
+                                        processor.setAnalogModel (result - idAnalogModel);
+                                    break; // otherwise the user cancelled
                             }
                         });
 }
@@ -1,14 +1,14 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
-#include "fruity_knee_lut_8192-2.h"
+#include "FruityMatchBlock.h"
+#include "FruityMatchADAA.h"
+#include "AnalogKneeADAA.h"
+#include "FastMath.h"
+#include "StereoHalfbandOversampler.h"
 #include <cmath>
-
-static inline float smoothStep01 (float x) noexcept
-{
-    x = juce::jlimit (0.0f, 1.0f, x);
-    return x * x * (3.0f - 2.0f * x);
-}
+#include <cstring>
+#include <algorithm>
 
 static inline float sin9Poly (float x) noexcept
 {
@@ -20,29 +20,6 @@ static inline float sin9Poly (float x) noexcept
     return 9.0f * x - 120.0f * x3 + 432.0f * x5 - 576.0f * x7 + 256.0f * x9;
 }
 
-static inline float fruityClipperDigital (float x) noexcept
-{
-    constexpr float kneeStart  = 0.9922f;   // slightly earlier onset
-    constexpr float blendWidth = 0.00035f;  // MUCH tighter blend
-
-    const float ax = std::abs (x);
-
-    if (ax <= kneeStart)
-        return x;
-
-    float y = FruityMatch::processSample (x);
-
-    if (ax < kneeStart + blendWidth)
-    {
-        float t = (ax - kneeStart) / blendWidth;
-        t = juce::jlimit (0.0f, 1.0f, t);
-        t = t * t * (3.0f - 2.0f * t); // smoothstep
-        y = x + (y - x) * t;
-    }
-
-    return y;
-}
-
 //==============================================================
 // Parameter layout
 //==============================================================
@@ -79,11 +56,51 @@ FruityClipAudioProcessor::createParameterLayout()
         "clipMode", "Mode",
         juce::StringArray { "Digital", "Analog" }, 0));
 
+    // ANALOG MODEL – index into AnalogEngine::kVariants (knee, hard, knee table).
+    // Saved with the session; new instances start from the global default.
+    {
+        juce::StringArray analogModels;
+        for (int model = 0; model < (int) AnalogEngine::Model::numModels; ++model)
+            analogModels.add (AnalogEngine::kVariants[model].name);
+
+        params.push_back (std::make_unique<juce::AudioParameterChoice>(
+            "analogModel", "Analog Model", analogModels, 0));
+    }
+
     // OVERSAMPLE MODE – 0:x1, 1:x2, 2:x4, 3:x8, 4:x16, 5:x32, 6:x64
     params.push_back (std::make_unique<juce::AudioParameterChoice>(
         "oversampleMode", "Oversample Mode",
         juce::StringArray { "x1", "x2", "x4", "x8", "x16", "x32", "x64" }, 0));
 
+    // ALIAS – clipper antiderivative anti-aliasing: 0 = off, 1 = 1st order, 2 = 2nd order
+    //         (ANALOG knee: 1st order for both, see AnalogKneeADAA.h)
+    params.push_back (std::make_unique<juce::AudioParameterChoice>(
+        "adaaMode", "Anti-Alias Mode",
+        juce::StringArray { "Off", "ADAA 1", "ADAA 2" }, 0));
+
+    // OVERSAMPLE QUALITY – halfband filter tier: 0 = Eco, 1 = Balanced, 2 = Max
+    params.push_back (std::make_unique<juce::AudioParameterChoice>(
+        "osQuality", "Oversample Quality",
+        juce::StringArray { "Eco", "Balanced", "Max" }, 2));
+
+    // LINEAR PHASE – FIR equiripple oversampling filters instead of the IIR tiers
+    params.push_back (std::make_unique<juce::AudioParameterBool>(
+        "osLinearPhase", "Oversample Linear Phase", false));
+
+    // OVERSAMPLE TARGET – pick the factor from a target internal rate instead (index 0 = off)
+    params.push_back (std::make_unique<juce::AudioParameterChoice>(
+        "osTargetRate", "Oversample Target Rate",
+        juce::StringArray { "Off", "176.4 kHz", "352.8 kHz", "705.6 kHz", "1.41 MHz" }, 0));
+
+    // AUTO OVERSAMPLE – realtime factor follows the CPU budget, oversampleMode is the maximum
+    params.push_back (std::make_unique<juce::AudioParameterBool>(
+        "osAuto", "Oversample Auto", false));
+
+    // TRUE-PEAK CEILING – look-ahead ISP control at base rate (index 0 = off)
+    params.push_back (std::make_unique<juce::AudioParameterChoice>(
+        "tpCeiling", "True Peak Ceiling",
+        juce::StringArray { "Off", "0.0 dBTP", "-0.3 dBTP", "-1.0 dBTP", "-2.0 dBTP" }, 0));
+
     params.push_back (std::make_unique<juce::AudioParameterChoice>(
         "lookMode", "Look Mode",
         juce::StringArray { "COOKED", "LUFS", "STATIC" }, 0));
@@ -160,6 +177,25 @@ FruityClipAudioProcessor::FruityClipAudioProcessor()
         storedOfflineOversampleIndex =
             userSettings->getIntValue ("offlineOversampleIndex", -1);
 
+        // ------------------------------------------------------
+        // DIGITAL knee evaluator (0 = LUT, 1 = polynomial)
+        // ------------------------------------------------------
+        digitalCurve.store (juce::jlimit (0, 1, userSettings->getIntValue ("digitalCurve", 0)));
+
+        // ------------------------------------------------------
+        // Multi-core oversampling (off unless asked for)
+        // ------------------------------------------------------
+        multiCore.store (userSettings->getBoolValue ("multiCore", false));
+
+        // ------------------------------------------------------
+        // ANALOG model global default (AnalogEngine::kVariants):
+        // pushed into the parameter for new instances, a restored
+        // session overrides it
+        // ------------------------------------------------------
+        if (auto* modelParam = dynamic_cast<juce::AudioParameterChoice*> (parameters.getParameter ("analogModel")))
+            *modelParam = juce::jlimit (0, (int) AnalogEngine::Model::numModels - 1,
+                                        getStoredAnalogModel());
+
         // ------------------------------------------------------
         // LIVE oversample global default
         // ------------------------------------------------------
@@ -236,15 +272,15 @@ void FruityClipAudioProcessor::setStoredLookMode (int modeIndex)
 int FruityClipAudioProcessor::getStoredOfflineOversampleIndex() const
 {
     if (userSettings)
-        return juce::jlimit (-1, 6,
+        return juce::jlimit (-1, kOfflineIndexLast,
             userSettings->getIntValue ("offlineOversampleIndex", storedOfflineOversampleIndex));
 
-    return juce::jlimit (-1, 6, storedOfflineOversampleIndex);
+    return juce::jlimit (-1, kOfflineIndexLast, storedOfflineOversampleIndex);
 }
 
 void FruityClipAudioProcessor::setStoredOfflineOversampleIndex (int index)
 {
-    index = juce::jlimit (-1, 6, index);
+    index = juce::jlimit (-1, kOfflineIndexLast, index);
     storedOfflineOversampleIndex = index;
 
     if (userSettings)
@@ -265,97 +301,313 @@ void FruityClipAudioProcessor::setStoredLiveOversampleIndex (int index)
     storedLiveOversampleIndex = index;
 }
 
-//==============================================================
-// Oversampling config helper
-//==============================================================
-void FruityClipAudioProcessor::updateAnalogClipperCoefficients()
+int FruityClipAudioProcessor::getStoredDigitalCurve() const
 {
-    const float osFactor = (float) juce::jmax (1, currentOversampleFactor);
-    const float srEff    = (float) sampleRate * osFactor;
+    return digitalCurve.load();
+}
 
-    if (srEff <= 0.0f)
-        return;
+void FruityClipAudioProcessor::setStoredDigitalCurve (int index)
+{
+    index = juce::jlimit (0, 1, index);
+    digitalCurve.store (index);
 
-    // Bias envelope follower coefficients (slow vs waveform, fast vs transients)
+    if (userSettings)
     {
-        const float attackMs  = 1.5f;
-        const float releaseMs = 35.0f;
-        const float aTau = attackMs  * 0.001f;
-        const float rTau = releaseMs * 0.001f;
-
-        analogEnvAttackAlpha  = std::exp (-1.0f / (aTau * srEff));
-        analogEnvReleaseAlpha = std::exp (-1.0f / (rTau * srEff));
-        analogEnvAttackAlpha  = juce::jlimit (0.0f, 0.9999999f, analogEnvAttackAlpha);
-        analogEnvReleaseAlpha = juce::jlimit (0.0f, 0.9999999f, analogEnvReleaseAlpha);
+        userSettings->setValue ("digitalCurve", index);
+        userSettings->saveIfNeeded();
     }
+}
 
-    // Transient envelope smoothing (fast/slow) for analog memory
-    {
-        const float fastTau = 0.0015f; // 1.5 ms
-        const float slowTau = 0.035f;  // 35 ms
-        analogFastEnvA = juce::jlimit (0.0f, 0.9999999f, std::exp (-1.0f / (fastTau * srEff)));
-        analogSlowEnvA = juce::jlimit (0.0f, 0.9999999f, std::exp (-1.0f / (slowTau * srEff)));
-    }
+int FruityClipAudioProcessor::getAnalogModel() const
+{
+    if (auto* p = parameters.getRawParameterValue ("analogModel"))
+        return juce::jlimit (0, (int) AnalogEngine::Model::numModels - 1, (int) p->load());
+
+    return 0;
+}
+
+void FruityClipAudioProcessor::setAnalogModel (int model)
+{
+    model = juce::jlimit (0, (int) AnalogEngine::Model::numModels - 1, model);
 
-    // Slew limiter coefficient (~8 kHz corner in REAL TIME, regardless of OS)
+    if (auto* modelParam = dynamic_cast<juce::AudioParameterChoice*> (parameters.getParameter ("analogModel")))
+        *modelParam = model;   // notifies the host, saved with the session
+
+    setStoredAnalogModel (model);
+}
+
+int FruityClipAudioProcessor::getStoredAnalogModel() const
+{
+    if (userSettings)
+        return userSettings->getIntValue ("analogModel", 0);
+    return 0;
+}
+
+void FruityClipAudioProcessor::setStoredAnalogModel (int model)
+{
+    if (userSettings)
     {
-        const float alphaSlew = std::exp (-2.0f * juce::MathConstants<float>::pi * 8000.0f / srEff);
-        analogSlewA = juce::jlimit (0.0f, 0.9999999f, alphaSlew);
+        userSettings->setValue ("analogModel", model);
+        userSettings->saveIfNeeded();
     }
+}
+
+bool FruityClipAudioProcessor::getStoredMultiCore() const
+{
+    return multiCore.load();
+}
+
+void FruityClipAudioProcessor::setStoredMultiCore (bool shouldUseWorker)
+{
+    // Start the worker here (message thread); it is only stopped when
+    // resources are released, so the audio thread never sees it go away.
+    if (shouldUseWorker)
+        channelWorker.start (getSampleRate(), getBlockSize());
+
+    multiCore.store (shouldUseWorker);
 
-    // Post-clip reconstruction smoothing (Lavry-ish HF damping)
+    if (userSettings)
     {
-        const float alphaRecon = std::exp (-2.0f * juce::MathConstants<float>::pi * 7000.0f / srEff);
-        analogReconA = juce::jlimit (0.0f, 0.9999999f, alphaRecon);
+        userSettings->setValue ("multiCore", shouldUseWorker);
+        userSettings->saveIfNeeded();
     }
+}
 
-    // Bias memory smoothing (~4 ms in real time)
+//==============================================================
+// Oversampling config helper
+//==============================================================
+void FruityClipAudioProcessor::updateAnalogClipperCoefficients()
+{
+    // Envelope / slew / recon / DC coefficients for the active model at the clipper's rate
+    analogRates = AnalogEngine::variant (activeAnalogModel).makeRates (sampleRate, juce::jmax (1, currentOversampleFactor));
+}
+
+void FruityClipAudioProcessor::prepareOversamplerBank (int numChannels)
+{
+    // Build every factor of every filter row up front so the audio thread
+    // never allocates. Factor index == osIndex: 0=x1 (no oversampler), 1=x2 ... 6=x64
+    oversampler = nullptr;
+
+    for (int index = 0; index < kNumOversampleModes; ++index)
     {
-        const float biasTau = 0.004f; // 4 ms
-        analogBiasA = juce::jlimit (0.0f, 0.9999999f, std::exp (-1.0f / (biasTau * srEff)));
+        const int numStages = index; // factor = 2^stages
+
+        // Base-rate sub-block whose oversampled working set stays cache-resident
+        oversampleSubBlocks[(size_t) index] = juce::jlimit (1, juce::jmax (1, maxBlockSize),
+                                                            kOsWorkingSetSamples >> numStages);
+
+        for (int filter = 0; filter < kNumOversampleFilters; ++filter)
+        {
+            auto& os = oversamplerBank[(size_t) filter][(size_t) index];
+            os.reset();
+            oversampleLatencies[(size_t) filter][(size_t) index] = 0;
+
+            if (numStages <= 0 || numChannels <= 0)
+                continue;
+
+            const auto quality = (OversamplingQuality) juce::jmin (filter, kNumOversampleQualities - 1);
+
+            if (filter == kOversampleLinearPhase)
+            {
+                // Linear phase: JUCE's max-quality equiripple FIR halfbands. Integer latency
+                // tops the (fractional) FIR delay up with a short allpass, so the host delay
+                // compensation and the prescan bypass stay sample-exact.
+                os = std::make_unique<JuceOversamplingEngine> (std::make_unique<juce::dsp::Oversampling<float>> (
+                    (size_t) numChannels,
+                    (size_t) numStages,
+                    juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple,
+                    true /* maximum quality */,
+                    true /* integer latency */));
+            }
+            // Mono / stereo (all this plugin supports) get the SIMD halfband engine
+            // (HalfbandCascade.h): JUCE's polyphase IIR stages at max quality, short
+            // FIR stages after the first at the lower tiers.
+            else if (numChannels <= 2)
+            {
+                os = std::make_unique<StereoHalfbandOversampler> (numChannels, numStages, quality);
+            }
+            else
+            {
+                auto juceOs = std::make_unique<juce::dsp::Oversampling<float>> ((size_t) numChannels);
+
+                // Same stage specs; FIR stages become JUCE's equiripple FIR, which
+                // meets the spec with different taps
+                for (int n = 0; n < numStages; ++n)
+                {
+                    const auto spec = getHalfbandStageSpec (quality, n);
+                    juceOs->addOversamplingStage (spec.fir ? juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple
+                                                           : juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
+                                                  spec.twUp, spec.dBUp, spec.twDown, spec.dBDown);
+                }
+
+                // integer latency, so the prescan bypass can match it with a plain delay
+                juceOs->setUsingIntegerLatency (true);
+
+                os = std::make_unique<JuceOversamplingEngine> (std::move (juceOs));
+            }
+
+            os->initProcessing ((size_t) oversampleSubBlocks[(size_t) index]);
+            os->reset();
+
+            oversampleLatencies[(size_t) filter][(size_t) index]
+                = juce::jlimit (0, kPrescanHistory - 1, (int) std::lround (os->getLatencyInSamples()));
+        }
     }
+
+    osSwitchScratch.setSize (juce::jmax (1, numChannels), juce::jmax (1, maxBlockSize));
+    osSwitchScratch.clear();
+    osSwitchFromIndex   = -1;
+    osSwitchFromFilter  = currentOversampleFilter;
+
+    clipSnapshot.adaa.resize (adaaStates.size());
 }
 
-void FruityClipAudioProcessor::updateOversampling (int osIndex, int numChannels)
+void FruityClipAudioProcessor::selectOversampler (int osIndex, int filter)
 {
     // osIndex: 0=x1, 1=x2, 2=x4, 3=x8, 4=x16, 5=x32, 6=x64
-    currentOversampleIndex = juce::jlimit (0, 6, osIndex);
+    // filter:  0..2 = IIR OversamplingQuality (eco, balanced, max), 3 = linear phase
+    // Only switches the active bank entry – safe on the audio thread.
+    currentOversampleIndex  = juce::jlimit (0, kNumOversampleModes - 1, osIndex);
+    currentOversampleFilter = juce::jlimit (0, kNumOversampleFilters - 1, filter);
+    oversampler             = oversamplerBank[(size_t) currentOversampleFilter][(size_t) currentOversampleIndex].get();
+    oversampleSubBlock      = oversampleSubBlocks[(size_t) currentOversampleIndex];
+    currentOversampleFactor = 1 << currentOversampleIndex; // 1,2,4,8,16,32,64
+    prescanLatency          = oversampleLatencies[(size_t) currentOversampleFilter][(size_t) currentOversampleIndex];
+
+    updateAnalogClipperCoefficients();
+}
 
-    int numStages = 0; // factor = 2^stages
-    switch (currentOversampleIndex)
+int FruityClipAudioProcessor::planOversampleIndex (const juce::AudioBuffer<float>& buffer,
+                                                   float clipThreshold, float aliasTargetDb) const
+{
+    // Analysis pass over the region at base rate:
+    //   - how far the peak exceeds the clip threshold
+    //   - rms frequency from first-difference vs signal energy (HF weighting)
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples  = buffer.getNumSamples();
+
+    if (numSamples < 2 || sampleRate <= 0.0)
+        return kNumOversampleModes - 1;
+
+    float  peak = 0.0f;
+    double energy = 0.0, diffEnergy = 0.0;
+
+    for (int ch = 0; ch < numChannels; ++ch)
     {
-        case 0: numStages = 0; break; // x1 (no oversampling)
-        case 1: numStages = 1; break; // x2
-        case 2: numStages = 2; break; // x4
-        case 3: numStages = 3; break; // x8
-        case 4: numStages = 4; break; // x16
-        case 5: numStages = 5; break; // x32
-        case 6: numStages = 6; break; // x64
-        default: numStages = 0; break;
+        const float* x = buffer.getReadPointer (ch);
+        peak = juce::jmax (peak, buffer.getMagnitude (ch, 0, numSamples));
+
+        for (int i = 1; i < numSamples; ++i)
+        {
+            const double d = (double) x[i] - (double) x[i - 1];
+            energy     += (double) x[i] * (double) x[i];
+            diffEnergy += d * d;
+        }
     }
 
-    currentOversampleFactor = 1 << numStages; // 1,2,4,8,16,32,64
+    const float over = peak / clipThreshold;
+    if (over <= 1.0f || energy <= 0.0)
+        return 0; // never reaches the curve: nothing to alias
 
-    if (numStages <= 0 || numChannels <= 0)
+    // Level of the 3rd harmonic vs the fundamental for a sine this far over the
+    // DIGITAL knee (measured); harmonics above it fall ~40 dB / decade.
+    static constexpr std::array<float, 6> overRatio { 1.00f,   1.02f,  1.10f,  1.30f,  2.00f,  4.00f };
+    static constexpr std::array<float, 6> thirdDb   { -120.0f, -55.0f, -32.0f, -20.5f, -13.0f, -10.0f };
+
+    float third = thirdDb.back();
+    for (size_t i = 1; i < overRatio.size(); ++i)
     {
-        oversampler.reset();
-        currentOversampleFactor = 1;
-        updateAnalogClipperCoefficients();
-        return;
+        if (over <= overRatio[i])
+        {
+            const float t = (over - overRatio[i - 1]) / (overRatio[i] - overRatio[i - 1]);
+            third = thirdDb[i - 1] + t * (thirdDb[i] - thirdDb[i - 1]);
+            break;
+        }
     }
 
-    oversampler = std::make_unique<juce::dsp::Oversampling<float>> (
-        numChannels,
-        numStages,
-        juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
-        true /* maximum quality */);
+    // |x[n] - x[n-1]| = 2 sin (pi f / fs) |x| for a sine
+    const double s   = juce::jlimit (0.0, 1.0, 0.5 * std::sqrt (diffEnergy / energy));
+    const double fHz = juce::jmax (20.0, sampleRate / juce::MathConstants<double>::pi * std::asin (s));
 
-    oversampler->reset();
+    for (int index = 0; index < kNumOversampleModes; ++index)
+    {
+        // First harmonic that folds back into the base band at factor 2^index
+        const double factor  = (double) (1 << index);
+        const double kFolded = juce::jmax (3.0, (factor * sampleRate - 0.5 * sampleRate) / fHz);
+        const double aliasDb = third - 40.0 * std::log10 (kFolded / 3.0);
 
-    if (maxBlockSize > 0)
-        oversampler->initProcessing ((size_t) maxBlockSize);
+        if (aliasDb <= aliasTargetDb)
+            return index;
+    }
 
-    updateAnalogClipperCoefficients();
+    return kNumOversampleModes - 1;
+}
+
+int FruityClipAudioProcessor::getOversampleIndexForRate (double baseRate, double targetRate) noexcept
+{
+    if (baseRate <= 0.0 || targetRate <= baseRate)
+        return 0;
+
+    // 0.1% slack so 44.1 kHz x 8 counts as reaching 352.8 kHz
+    int index = 0;
+    while (index < kNumOversampleModes - 1 && baseRate * (double) (1 << index) < targetRate * 0.999)
+        ++index;
+
+    return index;
+}
+
+void FruityClipAudioProcessor::updateReportedLatency()
+{
+    // Padded clip-path latency plus the true-peak look-ahead when it is on
+    setLatencySamples (clipLatencyTarget
+                       + (currentTpCeiling > 0 ? TruePeakLimiter::getLatencyInSamples() : 0));
+}
+
+int FruityClipAudioProcessor::getClipLatencyTarget (int filter, int osIndex, int automaticCeiling) const
+{
+    // The active factor's own latency, or – when the processor picks factors
+    // by itself up to automaticCeiling – the largest of those (ClipLatency.h)
+    filter = juce::jlimit (0, kNumOversampleFilters - 1, filter);
+
+    return ClipLatency::reported (oversampleLatencies[(size_t) filter].data(),
+                                  juce::jlimit (0, kNumOversampleModes - 1, osIndex),
+                                  juce::jmin (automaticCeiling, kNumOversampleModes - 1));
+}
+
+void FruityClipAudioProcessor::processBypassDelay (juce::AudioBuffer<float>& buffer, bool bypassed)
+{
+    // Always records the input, so entering BYPASS has history to read back
+    const int numChannels = juce::jmin (buffer.getNumChannels(), bypassDelay.getNumChannels());
+    const int numSamples  = buffer.getNumSamples();
+
+    if (numChannels <= 0)
+        return;
+
+    const int delay = juce::jlimit (0, kBypassDelayMax - 1,
+                                    clipLatencyTarget + (currentTpCeiling > 0 ? TruePeakLimiter::getLatencyInSamples() : 0));
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        float* s    = buffer.getWritePointer (ch);
+        float* ring = bypassDelay.getWritePointer (ch);
+        int write   = bypassDelayWrite;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            ring[write] = s[i];
+
+            if (bypassed)
+            {
+                const int read = write - delay;
+                s[i] = ring[read < 0 ? read + kBypassDelayMax : read];
+            }
+
+            if (++write == kBypassDelayMax)
+                write = 0;
+        }
+    }
+
+    bypassDelayWrite = (bypassDelayWrite + numSamples) % kBypassDelayMax;
 }
 
 //==============================================================
@@ -372,16 +624,22 @@ void FruityClipAudioProcessor::prepareToPlay (double newSampleRate, int samplesP
     limiterReleaseCo = std::exp (-1.0f / (releaseTimeSec * (float) sampleRate));
 
     // Reset K-weight filter + LUFS state
-    resetKFilterState (getTotalNumOutputChannels());
+    resetKFilterState();
     lufsMeanSquare = 1.0e-6f;
     lufsAverageLufs = -60.0f;
 
     // Reset SAT bass-tilt state
-    resetSatState (getTotalNumOutputChannels());
+    resetSatState();
 
-    resetSilkState (getTotalNumOutputChannels());
-    resetAnalogClipState (getTotalNumOutputChannels());
-    resetAnalogTransientState (getTotalNumOutputChannels());
+    resetSilkState();
+    resetAnalogToneState();
+    resetAnalogClipState();
+    resetAdaaState (getTotalNumOutputChannels());
+
+    // Knob coefficients depend on the rate: first block jumps, no ramp
+    silkRamp.reset();
+    toneRamp.reset();
+    satRamp.reset();
 
     const float sr = (float) sampleRate;
 
@@ -410,19 +668,95 @@ void FruityClipAudioProcessor::prepareToPlay (double newSampleRate, int samplesP
         analogToneAlpha10k = juce::jlimit (0.0f, 1.0f, alphaH);
     }
 
-    dsmCaptureEq.prepare (sampleRate, getTotalNumInputChannels());
+    // Every channel processBlock can see (ChannelLanes::kLanes at most), so
+    // the audio thread never resizes the filter state
+    dsmCaptureEq.prepare (sampleRate, juce::jmax (ChannelLanes::kLanes, getTotalNumInputChannels(),
+                                                  getTotalNumOutputChannels()));
+
+    resetDigitalPrescan (getTotalNumOutputChannels());
+
+    // Oversampler bank (all factors), then the initial factor from the parameter
+    prepareOversamplerBank (getTotalNumOutputChannels());
 
-    // Initial oversampling setup from parameter
+    int initialOsIndex = 0;
     if (auto* osModeParam = parameters.getRawParameterValue ("oversampleMode"))
+        initialOsIndex = (int) osModeParam->load();
+
+    if (auto* targetParam = parameters.getRawParameterValue ("osTargetRate"))
     {
-        const int osIndex = (int) osModeParam->load();
-        updateOversampling (osIndex, getTotalNumOutputChannels());
+        const int targetIndex = juce::jlimit (0, (int) kOsTargetRates.size() - 1, (int) targetParam->load());
+
+        if (targetIndex > 0)
+            initialOsIndex = getOversampleIndexForRate (sampleRate, kOsTargetRates[(size_t) targetIndex]);
     }
-    else
+
+    int initialOsFilter = (int) OversamplingQuality::max;
+    if (auto* osQualityParam = parameters.getRawParameterValue ("osQuality"))
+        initialOsFilter = (int) osQualityParam->load();
+
+    if (auto* linearPhaseParam = parameters.getRawParameterValue ("osLinearPhase"))
+        if (linearPhaseParam->load() > 0.5f)
+            initialOsFilter = kOversampleLinearPhase;
+
+    // An offline render starts on its own choice; the planner reports the
+    // largest latency it may pick now, and holds it for the whole render.
+    // Auto (realtime) reports the user's factor and pads the steps below it.
+    int automaticCeiling = -1;
+
+    if (isNonRealtime())
+    {
+        const int offlineIdx = getStoredOfflineOversampleIndex();
+
+        if (offlineIdx >= kOfflinePlanFirst)
+            automaticCeiling = kNumOversampleModes - 1;
+        else if (offlineIdx >= 0)
+            initialOsIndex = offlineIdx;
+    }
+    else if (auto* osAutoParam = parameters.getRawParameterValue ("osAuto"))
     {
-        updateOversampling (0, getTotalNumOutputChannels());
+        if (osAutoParam->load() >= 0.5f)
+            automaticCeiling = initialOsIndex;
     }
 
+    activeAnalogModel = getAnalogModel();
+    selectOversampler (initialOsIndex, initialOsFilter);
+    autoOsController.reset (kNumOversampleModes - 1);
+
+    clipLatencyTarget = getClipLatencyTarget (currentOversampleFilter, currentOversampleIndex, automaticCeiling);
+
+    // Channel worker for the multi-core clip stage, and its private copy of
+    // channel 1 (the largest oversampled sub-block it is handed). Stopped
+    // first: an abandoned job may still be writing the old copy.
+    channelWorker.stop();
+
+    {
+        size_t largest = 0;
+        for (int index = 0; index < kNumOversampleModes; ++index)
+            if ((1 << index) >= kParallelMinFactor)
+                largest = juce::jmax (largest, (size_t) oversampleSubBlocks[(size_t) index] << index);
+
+        channelJob.samples.assign (largest, 0.0f);
+        channelJob.adaa.resize (1);
+    }
+
+    if (multiCore.load())
+        channelWorker.start (sampleRate, maxBlockSize);
+
+    // Bypass delay (longest OS latency + true-peak look-ahead)
+    bypassDelay.setSize (getTotalNumOutputChannels(), kBypassDelayMax);
+    bypassDelay.clear();
+    bypassDelayWrite = 0;
+
+    // True-peak ceiling
+    truePeakLimiter.prepare (getTotalNumOutputChannels(), sampleRate);
+
+    currentTpCeiling = 0;
+    if (auto* tpParam = parameters.getRawParameterValue ("tpCeiling"))
+        currentTpCeiling = juce::jlimit (0, (int) kTpCeilingDb.size() - 1, (int) tpParam->load());
+
+    truePeakLimiter.setCeilingDb (kTpCeilingDb[(size_t) currentTpCeiling]);
+    updateReportedLatency();
+
     // Reset GUI signal envelope for LUFS gating
     guiSignalEnv.store (0.0f);
 
@@ -433,7 +767,10 @@ void FruityClipAudioProcessor::prepareToPlay (double newSampleRate, int samplesP
         setLookModeIndex (clampedLook);
 }
 
-void FruityClipAudioProcessor::releaseResources() {}
+void FruityClipAudioProcessor::releaseResources()
+{
+    channelWorker.stop();
+}
 
 bool FruityClipAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
 {
@@ -445,101 +782,77 @@ bool FruityClipAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
 //==============================================================
 // K-weight filter reset
 //==============================================================
-void FruityClipAudioProcessor::resetKFilterState (int numChannels)
+void FruityClipAudioProcessor::resetKFilterState()
 {
-    kFilterStates.clear();
-    if (numChannels <= 0)
-        return;
-
-    kFilterStates.resize ((size_t) numChannels);
-    for (auto& st : kFilterStates)
-    {
-        st.z1a = st.z2a = 0.0f;
-        st.z1b = st.z2b = 0.0f;
-    }
+    laneState.kZ1a = laneState.kZ2a = {};
+    laneState.kZ1b = laneState.kZ2b = {};
 }
 
-void FruityClipAudioProcessor::resetSilkState (int numChannels)
+void FruityClipAudioProcessor::resetSilkState()
 {
-    silkStates.clear();
-
-    if (numChannels <= 0)
-        return;
-
-    silkStates.resize ((size_t) numChannels);
-
-    for (auto& st : silkStates)
-    {
-        st.pre = 0.0f;
-        st.de  = 0.0f;
-        st.evenDc = 0.0f;
-    }
+    laneState.silkPre    = {};
+    laneState.silkDe     = {};
+    laneState.silkEvenDc = {};
 }
 
 //==============================================================
 // SAT bass-tilt reset
 //==============================================================
-void FruityClipAudioProcessor::resetSatState (int numChannels)
+void FruityClipAudioProcessor::resetSatState()
 {
-    satStates.clear();
-    if (numChannels <= 0)
-        return;
-
-    satStates.resize ((size_t) numChannels);
-    for (auto& st : satStates)
-        st.low = 0.0f;
+    laneState.satLow = {};
 }
 
 //==============================================================
 // Analog tone-match reset
 //==============================================================
-void FruityClipAudioProcessor::resetAnalogToneState (int numChannels)
+void FruityClipAudioProcessor::resetAnalogToneState()
 {
-    analogToneStates.clear();
+    laneState.toneLow250 = {};
+    laneState.toneLow10k = {};
+}
 
-    if (numChannels <= 0)
-        return;
+void FruityClipAudioProcessor::resetAnalogClipState()
+{
+    analogClipLanes = {};
+}
 
-    analogToneStates.resize ((size_t) numChannels);
-    for (auto& st : analogToneStates)
-    {
-        st.low250 = 0.0f;
-        st.low10k = 0.0f;
-    }
+//==============================================================
+// DIGITAL ADAA state reset
+//==============================================================
+void FruityClipAudioProcessor::resetAdaaState (int numChannels)
+{
+    // Also called from processBlock on an order change: assign() keeps the
+    // capacity, so this only allocates the first time (prepareToPlay).
+    adaaStates.assign ((size_t) juce::jmax (0, numChannels), FruityMatch::AdaaState {});
 }
 
-void FruityClipAudioProcessor::resetAnalogTransientState (int numChannels)
+//==============================================================
+// DIGITAL peak prescan reset
+//==============================================================
+void FruityClipAudioProcessor::resetDigitalPrescan (int numChannels)
 {
-    analogTransientStates.clear();
+    prescanQuietSamples = 0;
+    prescanBypassed     = false;
+    osDutyOversampled   = 0;
+    osDutyTotal         = 0;
+    guiOversampleDuty.store (0.0f);
 
     if (numChannels <= 0)
-        return;
-
-    analogTransientStates.resize ((size_t) numChannels);
-    for (auto& st : analogTransientStates)
     {
-        st.fastEnv = 0.0f;
-        st.slowEnv = 0.0f;
-        st.slew    = 0.0f;
-        st.prev    = 0.0f;
+        prescanDry.setSize (0, 0);
+        clipAligner.prepare (0, kPrescanHistory, maxBlockSize);
+        prescanScratch.setSize (0, 0);
+        return;
     }
-}
 
-void FruityClipAudioProcessor::resetAnalogClipState (int numChannels)
-{
-    analogClipStates.clear();
-    if (numChannels <= 0)
-        return;
+    prescanDry.setSize (numChannels, kPrescanHistory + juce::jmax (1, maxBlockSize));
+    prescanDry.clear();
 
-    analogClipStates.resize ((size_t) numChannels);
-    for (auto& st : analogClipStates)
-    {
-        st.biasMemory = 0.0f;
-        st.levelEnv   = 0.0f;
-        st.dcBlock    = 0.0f;
-        st.postLP1    = 0.0f;
-        st.postLP2    = 0.0f;
-    }
+    clipAligner.prepare (numChannels, kPrescanHistory, maxBlockSize);
+
+    prescanScratch.setSize (numChannels, kPrescanHistory);
+    prescanScratch.clear();
 }
 
 //==============================================================
@@ -569,321 +882,765 @@ float FruityClipAudioProcessor::processLimiterSample (float x)
     return x * limiterGain;
 }
 
-float FruityClipAudioProcessor::applySilkPreEmphasis (float x, int channel, float silkAmount)
+//==============================================================
+// Control-rate coefficients (once per block)
+//==============================================================
+FruityClipAudioProcessor::SilkCoeffs FruityClipAudioProcessor::makeSilkCoeffs (float silkAmount) const
+{
+    SilkCoeffs c;
+
+    // The SILK stage shapes the knob, and the emphasis filters shape it again
+    const float s   = std::pow (juce::jlimit (0.0f, 1.0f, silkAmount), 0.8f);
+    const bool  on  = s > 1.0e-6f;
+    const float amt = on ? std::pow (s, 0.8f) : 0.0f;
+
+    if (sampleRate > 0.0)
+    {
+        // One-pole lowpass around a few kHz to derive a "low" band
+        const float preFc = juce::jmap (amt, 0.0f, 1.0f, 2400.0f, 6500.0f);
+        c.preAlpha = std::exp (-2.0f * juce::MathConstants<float>::pi * preFc / (float) sampleRate);
+
+        // One-pole lowpass in the upper band to gently smooth top end
+        const float deFc = juce::jmap (amt, 0.0f, 1.0f, 9500.0f, 6200.0f);
+        c.deAlpha = std::exp (-2.0f * juce::MathConstants<float>::pi * deFc / (float) sampleRate);
+    }
+
+    // Gentle HF tilt – starts at 0, tops out around +2–2.5 dB-ish
+    c.preTilt = juce::jmap (amt, 0.0f, 1.0f, 0.0f, 0.32f);
+    c.deBlend = juce::jmap (amt, 0.0f, 1.0f, 0.0f, 0.42f);
+
+    // Desired total increase at 100%: +2.4 dB -> multiplier 10^(2.4/20)=1.318 -> delta gain 0.318
+    constexpr float silkEvenGain = 0.318f;
+
+    // delta-only: at s=0 => 1.0 (baseline unchanged), at s=1 => 1.318 (~+2.4 dB)
+    if (on)
+    {
+        const float evenGain = 1.0f + silkEvenGain * std::pow (s, 0.86f); // knob curve for even growth (tune later)
+        const auto& model    = AnalogEngine::variant (activeAnalogModel);
+
+        // The even-harmonic law is the ANALOG model's (AnalogEngine.h)
+        c.evenScale = model.evenScale (s, evenGain);
+        c.evenCap   = model.evenCap;
+    }
+
+    return c;
+}
+
+FruityClipAudioProcessor::ToneCoeffs FruityClipAudioProcessor::makeToneCoeffs (float silkAmount)
+{
+    // Same shaped control curve as the other silk code so the ear feels
+    // consistent: most of the "movement" is towards the top of the knob.
+    const float s = std::pow (juce::jlimit (0.0f, 1.0f, silkAmount), 0.8f);
+
+    // 3-band tilt target derived from measurements
+    const float lowDb  = juce::jmap (s, 0.0f, 1.0f, -0.28f, +0.37f);
+    const float midDb  = juce::jmap (s, 0.0f, 1.0f, -0.31f, +0.45f);
+    const float highDb = juce::jmap (s, 0.0f, 1.0f, -4.72f, -2.77f);
+
+    return { juce::Decibels::decibelsToGain (lowDb),
+             juce::Decibels::decibelsToGain (midDb),
+             juce::Decibels::decibelsToGain (highDb) };
+}
+
+FruityClipAudioProcessor::SatCoeffs FruityClipAudioProcessor::makeSatCoeffs (float satAmount)
+{
+    SatCoeffs c;
+
+    // --- STATIC INPUT TRIM ---
+    // At SAT = 0  -> 0 dB
+    // At SAT = 1  -> ~-0.5 dB
+    c.inputTrim = juce::Decibels::decibelsToGain (juce::jmap (satAmount, 0.0f, 1.0f, 0.0f, -0.5f));
+
+    c.tilt  = juce::jmap (satAmount, 0.0f, 1.0f, 0.0f, 0.85f);
+    c.drive = 1.0f + 5.0f * std::pow (satAmount, 1.3f);
+
+    // --- STATIC NORMALISATION (UNITY) ---
+    c.norm = 1.0f / FastMath::tanh (c.drive);
+    c.mix  = std::pow (satAmount, 1.0f);
+
+    return c;
+}
+
+FruityClipAudioProcessor::AnalogClipCoeffs FruityClipAudioProcessor::makeAnalogClipCoeffs (float silkAmount) const
+{
+    AnalogClipCoeffs c;
+
+    c.silkShape = std::pow (juce::jlimit (0.0f, 1.0f, silkAmount), 0.8f);
+
+    // Very gentle drive — we rely on bias & shape, not brute force
+    c.baseDrive = 1.0f + 0.04f * c.silkShape;
+    c.sRecon    = std::pow (c.silkShape, 1.56f);
+
+    // slope detector (stable across oversampling)
+    c.srEff = (float) sampleRate * (float) juce::jmax (1, currentOversampleFactor);
+
+    return c;
+}
+
+FruityClipAudioProcessor::LaneVec FruityClipAudioProcessor::applySilkPreEmphasis (LaneVec x, const SilkCoeffs& c)
+{
+    using namespace ChannelLanes;
+
+    if (sampleRate <= 0.0)
+        return x;
+
+    Vec low = load (laneState.silkPre);
+    onePole (low, broadcast (c.preAlpha), broadcast (1.0f - c.preAlpha), x);
+    store (low, laneState.silkPre);
+
+    const Vec high = x - low;
+
+    return x + broadcast (c.preTilt) * high;
+}
+
+FruityClipAudioProcessor::LaneVec FruityClipAudioProcessor::applySilkDeEmphasis (LaneVec x, const SilkCoeffs& c)
 {
+    using namespace ChannelLanes;
+
     if (sampleRate <= 0.0)
         return x;
 
-    auto& st = silkStates[(size_t) channel];
+    Vec de = load (laneState.silkDe);
+    onePole (de, broadcast (c.deAlpha), broadcast (1.0f - c.deAlpha), x);
+    store (de, laneState.silkDe);
 
-    // Shape the control for smoother response
-    const float s   = juce::jlimit (0.0f, 1.0f, silkAmount);
-    const float amt = std::pow (s, 0.8f);
+    return min (broadcast (2.5f), max (broadcast (-2.5f), x + broadcast (c.deBlend) * (de - x)));
+}
 
-    // One-pole lowpass around a few kHz to derive a "low" band
-    const float fc    = juce::jmap (amt, 0.0f, 1.0f, 2400.0f, 6500.0f);
-    const float alpha = std::exp (-2.0f * juce::MathConstants<float>::pi * fc / (float) sampleRate);
+FruityClipAudioProcessor::LaneVec FruityClipAudioProcessor::applySilkAnalogSample (LaneVec x, const SilkCoeffs& c)
+{
+    // 5060-style colour stage (pre-Lavry clip)
+    //
+    // Key fix:
+    // On already-clipped / flat-topped material, (pre * pre) becomes mostly DC,
+    // so the even-harmonic term collapses after DC removal. To keep even harmonics
+    // alive on hot material, we square the LOW band from the pre-emphasis split.
+    using namespace ChannelLanes;
+
+    if (c.evenScale <= 0.0f)
+    {
+        const Vec pre = applySilkPreEmphasis (x, c);
+        const Vec de  = applySilkDeEmphasis (pre, c);
+        return de;
+    }
+
+    // Pre-emphasis (updates silkPre as the low-band state)
+    const Vec pre = applySilkPreEmphasis (x, c);
 
-    st.pre = alpha * st.pre + (1.0f - alpha) * x;
+    // Engage more at high level so it doesn't fuzz quiet material
+    Vec driveT = min (broadcast (1.0f), max (broadcast (0.0f), (abs (pre) - broadcast (0.20f)) / broadcast (0.80f)));
+    driveT = driveT * driveT;
 
-    const float low  = st.pre;
-    const float high = x - low;
+    // --- EVEN HARMONICS (model's EvenLaw, per block in makeSilkCoeffs) ---
+    const Vec evenCoeff = driveT * broadcast (c.evenScale);
 
-    // Gentle HF tilt – starts at 0, tops out around +2–2.5 dB-ish
-    const float tilt = juce::jmap (amt, 0.0f, 1.0f, 0.0f, 0.32f);
+    // IMPORTANT: build even term from low-band so it doesn't vanish on flat tops
+    const Vec evenSrc = load (laneState.silkPre);
+    Vec e = evenSrc * evenSrc;
+
+    // Remove DC from quadratic term only (preserves even series)
+    Vec evenDc = load (laneState.silkEvenDc);
+    onePole (evenDc, broadcast (silkEvenDcAlpha), broadcast (1.0f - silkEvenDcAlpha), e);
+    store (evenDc, laneState.silkEvenDc);
+    e = e - evenDc;
+
+    // Cap to stop high-order even build-up
+    const Vec evenCoeffCapped = min (broadcast (c.evenCap), max (broadcast (0.0f), evenCoeff));
 
-    return x + tilt * high;
+    const Vec y = pre + evenCoeffCapped * e;
+
+    // De-emphasis
+    return applySilkDeEmphasis (y, c);
 }
 
-float FruityClipAudioProcessor::applySilkDeEmphasis (float x, int channel, float silkAmount)
+
+FruityClipAudioProcessor::LaneVec FruityClipAudioProcessor::applyAnalogToneMatch (LaneVec x, const ToneCoeffs& c)
 {
+    using namespace ChannelLanes;
+
+    // Safety: bail out if we don't have a valid sample rate
     if (sampleRate <= 0.0)
         return x;
 
-    auto& st = silkStates[(size_t) channel];
+    // -----------------------------------------------------------------
+    // 1) Split into three regions using two one-pole lowpasses:
+    //    low  : below ~250 Hz
+    //    mid  : 250 Hz – ~10 kHz
+    //    high : above ~10 kHz
+    // -----------------------------------------------------------------
+    Vec low = load (laneState.toneLow250);
+    onePole (low, broadcast (analogToneAlpha250), broadcast (1.0f - analogToneAlpha250), x);
+    store (low, laneState.toneLow250);
+
+    Vec midPlusLow = load (laneState.toneLow10k);
+    onePole (midPlusLow, broadcast (analogToneAlpha10k), broadcast (1.0f - analogToneAlpha10k), x);
+    store (midPlusLow, laneState.toneLow10k);
+
+    const Vec mid  = midPlusLow - low;
+    const Vec high = x - midPlusLow;
+
+    // -----------------------------------------------------------------
+    // 2) 3-band tilt from the shaped SILK control (makeToneCoeffs), clamp
+    // -----------------------------------------------------------------
+    const Vec y = broadcast (c.gainLow) * low + broadcast (c.gainMid) * mid + broadcast (c.gainHigh) * high;
+
+    // Safety clamp – we should never normally hit this,
+    // but it keeps the stage well-behaved in edge cases.
+    return min (broadcast (4.0f), max (broadcast (-4.0f), y));
+}
+
+//==============================================================
+// Clip stage (CLIP or LIMITER), at whatever rate the block is in
+//==============================================================
+void FruityClipAudioProcessor::processClipStage (juce::dsp::AudioBlock<float>& block, const ClipStageConfig& cfg)
+{
+    const int numChannels = (int) block.getNumChannels();
+    const int numSamples  = (int) block.getNumSamples();
+
+    // ANALOG runs all channels in one SIMD pass (lanes), which costs the same
+    // for one channel as for two; only its ADAA knee (double, per lane) is per
+    // channel work, so it is split onto the worker only with ADAA on.
+    // The limiter shares limiterGain across channels, so it always runs serially
+    const bool analog   = cfg.analogMode && ! cfg.limiterOn;
+    const bool parallel = numChannels == 2
+                       && ! cfg.limiterOn
+                       && (! analog || cfg.adaaOrder > 0)
+                       && currentOversampleFactor >= kParallelMinFactor
+                       && numSamples <= (int) channelJob.samples.size()
+                       && multiCore.load (std::memory_order_relaxed)
+                       && channelWorker.isRunning()
+                       && channelWorker.isFree();
+
+    if (analog)
+    {
+        if (parallel)
+            processAnalogClipParallel (block, cfg);
+        else
+            processAnalogClip (block, cfg);
+
+        return;
+    }
+
+    auto* adaa1 = adaaStates.size() > 1 ? &adaaStates[1] : nullptr;
+
+    if (parallel)
+    {
+        // The worker gets private copies of channel 1 and its state, so an
+        // abandoned job can simply be redone here
+        channelJob.processor  = this;
+        channelJob.numSamples = numSamples;
+        channelJob.cfg        = cfg;
+        channelJob.hasAdaa    = adaa1 != nullptr && ! channelJob.adaa.empty();
+
+        if (channelJob.hasAdaa)
+            channelJob.adaa[0] = *adaa1;
+
+        juce::FloatVectorOperations::copy (channelJob.samples.data(), block.getChannelPointer (1), numSamples);
+
+        channelWorker.post ([] (void* context)
+        {
+            auto& job = *static_cast<ChannelJob*> (context);
+            job.processor->processClipChannel (job.samples.data(), job.numSamples,
+                                               job.hasAdaa ? &job.adaa[0] : nullptr, job.cfg);
+        }, &channelJob);
+
+        const auto ownStart = juce::Time::getHighResolutionTicks();
+        processClipChannel (block.getChannelPointer (0), numSamples, adaaStates.empty() ? nullptr : &adaaStates[0], cfg);
+
+        // Channel 1 is the same work: past kWorkerMaxWait of our own time the worker is late
+        const double ownSeconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - ownStart);
+
+        if (channelWorker.finish (ownSeconds * kWorkerMaxWait))
+        {
+            juce::FloatVectorOperations::copy (block.getChannelPointer (1), channelJob.samples.data(), numSamples);
+
+            if (channelJob.hasAdaa)
+                *adaa1 = channelJob.adaa[0];
+        }
+        else
+        {
+            processClipChannel (block.getChannelPointer (1), numSamples, adaa1, cfg);
+        }
+
+        return;
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        processClipChannel (block.getChannelPointer ((size_t) ch), numSamples,
+                            ch < (int) adaaStates.size() ? &adaaStates[(size_t) ch] : nullptr, cfg);
+}
+
+void FruityClipAudioProcessor::processClipChannel (float* samples, int numSamples, FruityMatch::AdaaState* adaa,
+                                                   const ClipStageConfig& cfg)
+{
+    // Touches only the given channel state (plus limiterGain when the limiter
+    // is on), so two channels can run concurrently unless limiterOn.
+    if (! cfg.limiterOn)
+    {
+        if (cfg.adaaOrder > 0 && adaa != nullptr)
+        {
+            // DIGITAL clip, antiderivative anti-aliased (scalar, double precision)
+            FruityMatch::processAdaaBlock (samples, numSamples, *adaa, cfg.adaaOrder);
+        }
+        else
+        {
+            // DIGITAL clip (Fruity Clipper curve) – SIMD block kernel
+            const auto digitalKnee = cfg.digitalPoly ? FruityMatch::Curve::polynomial
+                                                     : FruityMatch::Curve::kneeLut;
+
+            FruityMatch::processBlock (samples, numSamples, digitalKnee);
+        }
+
+        return;
+    }
+
+    // SAT already applied previously if needed.
+    for (int i = 0; i < numSamples; ++i)
+        samples[i] = processLimiterSample (samples[i]);
+}
+
+void FruityClipAudioProcessor::processAnalogClip (juce::dsp::AudioBlock<float>& block, const ClipStageConfig& cfg)
+{
+    const int numChannels = juce::jmin ((int) block.getNumChannels(), ChannelLanes::kLanes);
+    const int numSamples  = (int) block.getNumSamples();
+
+    float* channels[ChannelLanes::kLanes] {};
+    for (int ch = 0; ch < numChannels; ++ch)
+        channels[ch] = block.getChannelPointer ((size_t) ch);
+
+    AnalogEngine::variant (activeAnalogModel).process (analogClipLanes, analogRates, cfg.analogClip,
+                                                       channels, numChannels, numSamples, cfg.adaaOrder > 0);
+}
+
+void FruityClipAudioProcessor::processAnalogClipParallel (juce::dsp::AudioBlock<float>& block, const ClipStageConfig& cfg)
+{
+    // Stereo, one lane per thread: channel 1 runs on the worker from a private
+    // copy of its lane state, channel 0 here in lane 0 of analogClipLanes. The
+    // engine's per-tick shortcuts (shape skip, linear tick) then decide per
+    // channel instead of for both, which can move the output by float rounding
+    // only (AnalogEngineLinearTest checks the split against a stereo pass).
+    const int numSamples = (int) block.getNumSamples();
+    const auto& model    = AnalogEngine::variant (activeAnalogModel);
+
+    // Lane 1 before the channel 0 pass, which runs it on silence
+    const auto lane1 = AnalogEngine::laneOf (analogClipLanes, 1);
+
+    channelJob.numSamples  = numSamples;
+    channelJob.cfg         = cfg;
+    channelJob.analogModel = &model;
+    channelJob.analogRates = analogRates;
+    channelJob.analogState = lane1;
+
+    juce::FloatVectorOperations::copy (channelJob.samples.data(), block.getChannelPointer (1), numSamples);
+
+    channelWorker.post ([] (void* context)
+    {
+        auto& job = *static_cast<ChannelJob*> (context);
+        float* channel[1] = { job.samples.data() };
+        job.analogModel->process (job.analogState, job.analogRates, job.cfg.analogClip,
+                                  channel, 1, job.numSamples, job.cfg.adaaOrder > 0);
+    }, &channelJob);
+
+    const auto ownStart = juce::Time::getHighResolutionTicks();
+
+    float* channel0[1] = { block.getChannelPointer (0) };
+    model.process (analogClipLanes, analogRates, cfg.analogClip, channel0, 1, numSamples, cfg.adaaOrder > 0);
+
+    const double ownSeconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - ownStart);
+
+    if (channelWorker.finish (ownSeconds * kWorkerMaxWait))
+    {
+        juce::FloatVectorOperations::copy (block.getChannelPointer (1), channelJob.samples.data(), numSamples);
+        AnalogEngine::setLane (analogClipLanes, 1, channelJob.analogState);
+    }
+    else
+    {
+        auto state = lane1;
+        float* channel1[1] = { block.getChannelPointer (1) };
+        model.process (state, analogRates, cfg.analogClip, channel1, 1, numSamples, cfg.adaaOrder > 0);
+        AnalogEngine::setLane (analogClipLanes, 1, state);
+    }
+}
+
+void FruityClipAudioProcessor::processOversampledClip (juce::dsp::AudioBlock<float>& block, const ClipStageConfig& cfg)
+{
+    // up -> clip -> down per sub-block, so the oversampled data is consumed
+    // while still in cache instead of streaming factor x block through memory
+    // three times. The oversampler is only prepared for oversampleSubBlock.
+    const size_t numSamples = block.getNumSamples();
+    const size_t step       = (size_t) juce::jmax (1, oversampleSubBlock);
+
+    for (size_t start = 0; start < numSamples; start += step)
+    {
+        auto sub     = block.getSubBlock (start, juce::jmin (step, numSamples - start));
+        auto osBlock = oversampler->processSamplesUp (sub);
+
+        processClipStage (osBlock, cfg);
+
+        oversampler->processSamplesDown (sub);
+    }
+}
+
+//==============================================================
+// Clip path at the active factor
+//==============================================================
+void FruityClipAudioProcessor::processClipChunk (juce::AudioBuffer<float>& buffer, const ClipStageConfig& cfg,
+                                                 bool subKneeIsIdentity)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples  = buffer.getNumSamples();
+
+    const bool keepHistory = prescanDry.getNumChannels() >= numChannels
+                          && clipAligner.canProcess (numChannels, numSamples)
+                          && prescanDry.getNumSamples() >= kPrescanHistory + numSamples;
 
-    // Same shaped control
-    const float s   = juce::jlimit (0.0f, 1.0f, silkAmount);
-    const float amt = std::pow (s, 0.8f);
+    // Input behind the history: read by the prescan bypass and the switch pre-roll
+    if (keepHistory)
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::copy (prescanDry.getWritePointer (ch, kPrescanHistory),
+                                               buffer.getReadPointer (ch), numSamples);
 
-    // One-pole lowpass in the upper band to gently smooth top end
-    const float fc    = juce::jmap (amt, 0.0f, 1.0f, 9500.0f, 6200.0f);
-    const float alpha = std::exp (-2.0f * juce::MathConstants<float>::pi * fc / (float) sampleRate);
+    if (osSwitchFromIndex >= 0)
+        processOversampleSwitch (buffer, cfg, subKneeIsIdentity, keepHistory);
+    else
+        processClipPath (buffer, cfg, subKneeIsIdentity);
 
-    st.de = alpha * st.de + (1.0f - alpha) * x;
+    if (! keepHistory)
+        return;
 
-    const float blend = juce::jmap (amt, 0.0f, 1.0f, 0.0f, 0.42f);
+    // Keep the most recent kPrescanHistory input samples for the next chunk
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        float* in = prescanDry.getWritePointer (ch);
+        std::memmove (in, in + numSamples, sizeof (float) * (size_t) kPrescanHistory);
+    }
 
-    return juce::jlimit (-2.5f, 2.5f, x + blend * (st.de - x));
+    // Output into the history, then delayed up to the reported latency
+    clipAligner.pad (buffer.getArrayOfWritePointers(), numChannels, numSamples, clipLatencyTarget - prescanLatency);
 }
 
-float FruityClipAudioProcessor::applySilkAnalogSample (float x, int channel, float silkAmount)
+void FruityClipAudioProcessor::processClipPath (juce::AudioBuffer<float>& buffer, const ClipStageConfig& cfg,
+                                                bool subKneeIsIdentity)
 {
-    // 5060-style colour stage (pre-Lavry clip)
-    //
-    // Key fix:
-    // On already-clipped / flat-topped material, (pre * pre) becomes mostly DC,
-    // so the even-harmonic term collapses after DC removal. To keep even harmonics
-    // alive on hot material, we square the LOW band from the pre-emphasis split.
+    if (oversampler != nullptr)
+    {
+        if (subKneeIsIdentity)
+        {
+            updateOversampleDuty (processDigitalPrescanned (buffer, cfg), buffer.getNumSamples());
+        }
+        else
+        {
+            juce::dsp::AudioBlock<float> block (buffer);
+            processOversampledClip (block, cfg);
+            updateOversampleDuty (buffer.getNumSamples(), buffer.getNumSamples());
+        }
 
-    const float s = std::pow (juce::jlimit (0.0f, 1.0f, silkAmount), 0.8f);
+        return;
+    }
 
-    if (channel < 0 || channel >= (int) silkStates.size())
-        return x;
+    updateOversampleDuty (0, buffer.getNumSamples());
+
+    //======================================================
+    // NO OVERSAMPLING – process at base rate only
+    //======================================================
+    // DIGITAL is the identity below the knee, so a block that never
+    // reaches it needs no clip pass at all.
+    bool needsClip = ! subKneeIsIdentity;
 
-    auto& st = silkStates[(size_t) channel];
+    for (int ch = 0; ch < buffer.getNumChannels() && ! needsClip; ++ch)
+        needsClip = buffer.getMagnitude (ch, 0, buffer.getNumSamples()) > FruityMatch::kKneeStart;
 
-    if (s <= 1.0e-6f)
+    if (needsClip)
     {
-        const float pre = applySilkPreEmphasis (x, channel, 0.0f);
-        const float de  = applySilkDeEmphasis (pre, channel, 0.0f);
-        return de;
+        juce::dsp::AudioBlock<float> block (buffer);
+        processClipStage (block, cfg);
     }
+}
 
-    // Pre-emphasis (updates st.pre as the low-band state)
-    const float pre = applySilkPreEmphasis (x, channel, s);
-
-    // Engage more at high level so it doesn't fuzz quiet material
-    float driveT = juce::jlimit (0.0f, 1.0f, (std::abs (pre) - 0.20f) / 0.80f);
-    driveT = driveT * driveT;
+//==============================================================
+// Oversampling factor switch (one crossfaded block)
+//==============================================================
+void FruityClipAudioProcessor::saveClipState()
+{
+    clipSnapshot.limiterGain = limiterGain;
+    clipSnapshot.analogClip  = analogClipLanes;
+    std::copy_n (adaaStates.begin(), juce::jmin (adaaStates.size(), clipSnapshot.adaa.size()), clipSnapshot.adaa.begin());
+}
 
-    // --- EVEN HARMONICS (delta-only on top of locked baseline) ---
-    const float sEven = std::pow (s, 0.86f); // knob curve for even growth (tune later)
+void FruityClipAudioProcessor::restoreClipState()
+{
+    limiterGain     = clipSnapshot.limiterGain;
+    analogClipLanes = clipSnapshot.analogClip;
+    std::copy_n (clipSnapshot.adaa.begin(), juce::jmin (adaaStates.size(), clipSnapshot.adaa.size()), adaaStates.begin());
+}
 
-    // Keep baseline constant (DO NOT depend on s)
-    constexpr float evenScale = 1.95f; // whatever value matches your locked SILK=0 baseline
-    constexpr float evenTrim  = 0.80f; // keep your baseline trim here
+void FruityClipAudioProcessor::processOversampleSwitch (juce::AudioBuffer<float>& buffer, const ClipStageConfig& cfg,
+                                                        bool subKneeIsIdentity, bool haveHistory)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples  = buffer.getNumSamples();
+    const int newIndex    = currentOversampleIndex;
+    const int newFilter   = currentOversampleFilter;
+    const int oldIndex    = osSwitchFromIndex;
+    const int oldFilter   = osSwitchFromFilter;
 
-    // Desired total increase at 100%: +2.4 dB -> multiplier 10^(2.4/20)=1.318 -> delta gain 0.318
-    constexpr float silkEvenGain = 0.318f;
+    osSwitchFromIndex = -1;
 
-    const float baseEven = evenScale * 0.028f * driveT * evenTrim;
+    if (! haveHistory || osSwitchScratch.getNumChannels() < numChannels || osSwitchScratch.getNumSamples() < numSamples)
+    {
+        prescanQuietSamples = 0;
+        prescanBypassed     = false;
+        processClipPath (buffer, cfg, subKneeIsIdentity);
+        return;
+    }
 
-    // delta-only: at s=0 => 1.0 (baseline unchanged), at s=1 => 1.318 (~+2.4 dB)
-    const float evenCoeff = baseEven * (1.0f + silkEvenGain * sEven);
+    // 1) Previous factor renders this block once more, on a copy. The clip
+    //    stage state is put back afterwards so the new factor continues from
+    //    exactly where the old one was.
+    juce::AudioBuffer<float> previous (osSwitchScratch.getArrayOfWritePointers(), numChannels, 0, numSamples);
 
-    // IMPORTANT: build even term from low-band so it doesn't vanish on flat tops
-    const float evenSrc = st.pre;
-    float e = evenSrc * evenSrc;
+    for (int ch = 0; ch < numChannels; ++ch)
+        juce::FloatVectorOperations::copy (previous.getWritePointer (ch), buffer.getReadPointer (ch), numSamples);
 
-    // Remove DC from quadratic term only (preserves even series)
-    st.evenDc = silkEvenDcAlpha * st.evenDc + (1.0f - silkEvenDcAlpha) * e;
-    e -= st.evenDc;
+    saveClipState();
+    selectOversampler (oldIndex, oldFilter);
 
-    // tighter cap to stop high-order even build-up
-    const float evenCoeffCapped = juce::jlimit (0.0f, 0.24f, evenCoeff);
+    if (oversampler != nullptr && prescanBypassed)
+    {
+        // It was passing the dry input through, delayed by its latency
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* s           = previous.getWritePointer (ch);
+            const float* hist  = prescanDry.getReadPointer (ch);
 
-    float y = pre + evenCoeffCapped * e;
+            // in place: s[i] depends on s[i - latency] only, so walk backwards
+            for (int i = numSamples - 1; i >= 0; --i)
+            {
+                const int src = i - prescanLatency;
+                s[i] = (src >= 0) ? s[src] : hist[kPrescanHistory + src];
+            }
+        }
+    }
+    else if (oversampler != nullptr)
+    {
+        juce::dsp::AudioBlock<float> block (previous);
+        processOversampledClip (block, cfg);
+    }
+    else
+    {
+        juce::dsp::AudioBlock<float> block (previous);
+        processClipStage (block, cfg);
+    }
 
-    // De-emphasis
-    return applySilkDeEmphasis (y, channel, s);
+    restoreClipState();
+    const int oldLatency = prescanLatency;
+    selectOversampler (newIndex, newFilter);
+
+    // 2) New factor (already reset) is pre-rolled on the input history, so its
+    //    filters hold the state they would have had if it had been running,
+    //    then processes the block for real
+    if (oversampler != nullptr)
+        warmUpOversampler (numChannels, 0, &cfg);
+
+    prescanQuietSamples = 0;
+    prescanBypassed     = false;
+    processClipPath (buffer, cfg, subKneeIsIdentity);
+
+    // 3) Crossfade old -> new, with the old output delay-aligned to the new
+    //    latency: new[i] renders input i - newLatency, which the old path
+    //    rendered at i - delta. The output history moves by delta too, so the
+    //    latency pad (processClipChunk) continues seamlessly.
+    clipAligner.crossfade (buffer.getArrayOfWritePointers(), previous.getArrayOfReadPointers(),
+                           numChannels, numSamples, prescanLatency - oldLatency, kOsSwitchFade);
 }
 
-
-float FruityClipAudioProcessor::applyClipperAnalogSample (float x, int channel, float silkAmount)
+//==============================================================
+// DIGITAL peak prescan
+//==============================================================
+void FruityClipAudioProcessor::warmUpOversampler (int numChannels, int historyStart, const ClipStageConfig* clipCfg)
 {
-    constexpr float threshold = 1.0f;
-    constexpr float baseKneeWidth = 0.38f;
-
-    auto softClip = [] (float v, float kneeWidth) noexcept
-    {
-        constexpr float threshold = 1.0f;
-
-        const float a = std::abs (v);
-        if (a <= threshold)
-            return v;
-
-        const float over   = a - threshold;
-        const float shaped = threshold + std::tanh (over / kneeWidth) * kneeWidth;
-        return std::copysign (shaped, v);
-    };
-
-    // Shaped SILK control
-    const float silkShape = std::pow (juce::jlimit (0.0f, 1.0f, silkAmount), 0.8f);
+    // Re-run the input history through a freshly reset oversampler. The IIR
+    // halfbands forget their reset state within the history length, so the
+    // filters continue as if they had never been bypassed / switched off.
+    // historyStart indexes prescanDry: the kPrescanHistory samples before block
+    // sample n start at n. Sub-knee history (prescan) needs no clip; a factor
+    // switch passes clipCfg so the down filters see clipped history, with the
+    // clip stage's own state put back afterwards (its output is discarded).
+    oversampler->reset();
 
-    // Per-channel state
-    if (channel < 0 || channel >= (int) analogClipStates.size() || channel >= (int) analogTransientStates.size())
-        return x;
+    if (clipCfg != nullptr)
+        saveClipState();
 
-    auto& st  = analogClipStates[(size_t) channel];
-    auto& ts  = analogTransientStates[(size_t) channel];
+    const int chunk = juce::jmin (prescanScratch.getNumSamples(), juce::jmax (1, oversampleSubBlock));
 
-    // Very gentle drive — we rely on bias & shape, not brute force
-    const float baseDrive = 1.0f + 0.04f * silkShape;
-    const float preEnv    = x * baseDrive;
-    const float absPre    = std::abs (preEnv);
+    for (int start = 0; start < kPrescanHistory; start += chunk)
+    {
+        const int n = juce::jmin (chunk, kPrescanHistory - start);
 
-    // -------------------------------------------------------------
-    // Fast/slow transient detector
-    // -------------------------------------------------------------
-    ts.fastEnv = analogFastEnvA * ts.fastEnv + (1.0f - analogFastEnvA) * absPre;
-    ts.slowEnv = analogSlowEnvA * ts.slowEnv + (1.0f - analogSlowEnvA) * absPre;
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::copy (prescanScratch.getWritePointer (ch),
+                                               prescanDry.getReadPointer (ch, historyStart + start), n);
 
-    const float transient    = juce::jmax (0.0f, ts.fastEnv - ts.slowEnv);
-    const float transientNorm = smoothStep01 (transient / 0.25f);
+        juce::dsp::AudioBlock<float> warm (prescanScratch);
+        auto sub = warm.getSubsetChannelBlock (0, (size_t) numChannels).getSubBlock (0, (size_t) n);
 
-    const float dynamicKnee  = baseKneeWidth * (1.0f + 0.35f * transientNorm);
-    const float dynamicDrive = baseDrive * (1.0f - 0.06f * transientNorm);
+        auto osBlock = oversampler->processSamplesUp (sub);
 
-    float inRaw = x * dynamicDrive;
+        if (clipCfg != nullptr)
+            processClipStage (osBlock, *clipCfg);
 
-    // Slew blend only when corners are steep (Lavry-style edge rounding)
-    const float pre    = inRaw;
-    const float slewed = analogSlewA * ts.slew + (1.0f - analogSlewA) * pre;
-    ts.slew = slewed;
+        oversampler->processSamplesDown (sub);
+    }
 
-    // slope detector (stable across oversampling)
-    const float srEff = (float) sampleRate * (float) juce::jmax (1, currentOversampleFactor);
-    const float dx    = pre - ts.prev;
-    ts.prev = pre;
+    if (clipCfg != nullptr)
+        restoreClipState();
+}
 
-    const float slopePerSec = std::abs (dx) * srEff;
+int FruityClipAudioProcessor::processDigitalPrescanned (juce::AudioBuffer<float>& buffer, const ClipStageConfig& cfg)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples  = buffer.getNumSamples();
 
-    // thresholds (start/end) — checkpoint values, we tune later
-    constexpr float gateStart = 9000.0f;
-    constexpr float gateEnd   = 26000.0f;
+    juce::dsp::AudioBlock<float> block (buffer);
 
-    // smoothstep
-    float g = (slopePerSec - gateStart) / (gateEnd - gateStart);
-    g = juce::jlimit (0.0f, 1.0f, g);
-    g = g * g * (3.0f - 2.0f * g);
+    const bool canPrescan = prescanDry.getNumChannels()     >= numChannels
+                         && prescanScratch.getNumChannels() >= numChannels
+                         && prescanDry.getNumSamples()      >= kPrescanHistory + numSamples;
 
-    // maxBlend controls “how Lavry” the rounding is
-    constexpr float maxBlend = 0.55f;
-    const float blend = maxBlend * g;
+    if (! canPrescan)
+    {
+        prescanQuietSamples = 0;
+        prescanBypassed     = false;
+        processOversampledClip (block, cfg);
+        return numSamples;
+    }
 
-    inRaw = pre + blend * (slewed - pre);
+    // prescanDry already holds this chunk's input behind the history (processClipChunk)
+    const float threshold   = FruityMatch::kKneeStart * kPrescanHeadroom;
+    const int   holdSamples = (int) (kPrescanHoldSeconds * sampleRate);
 
-    // -------------------------------------------------------------
-    // H9 fill disabled — keep Lavry stage clean/symmetric
-    // (5060 colour comes from SILK stage now)
-    // -------------------------------------------------------------
+    auto segmentPeak = [&] (int start) noexcept
+    {
+        const int n = juce::jmin (kPrescanSegment, numSamples - start);
+        float peak = 0.0f;
 
-    const float absIn = std::abs (inRaw);
+        for (int ch = 0; ch < numChannels; ++ch)
+            peak = juce::jmax (peak, buffer.getMagnitude (ch, start, n));
 
-    // -------------------------------------------------------------
-    // Slow envelope follower of |in| (so bias doesn't "follow" the sine)
-    // -------------------------------------------------------------
-    float env = st.levelEnv;
-    if (absIn > env)
-        env = analogEnvAttackAlpha * env + (1.0f - analogEnvAttackAlpha) * absIn;
-    else
-        env = analogEnvReleaseAlpha * env + (1.0f - analogEnvReleaseAlpha) * absIn;
+        return peak;
+    };
 
-    st.levelEnv = env;
+    int  osSamples = 0;
+    int  runStart  = 0;
+    bool runBypass = prescanBypassed;
 
-    // -------------------------------------------------------------
-    // Bias envelope (engages near clipping)
-    // -------------------------------------------------------------
-    constexpr float levelStart = 0.55f; // start engaging below threshold
-    constexpr float levelEnd   = 1.45f;
+    // Renders [runStart, end) through the path decided for it, crossfading
+    // from the other path at the start of the run when the decision flipped.
+    auto renderRun = [&] (int end)
+    {
+        const int n = end - runStart;
+        if (n <= 0)
+            return;
 
-    float levelT = 0.0f;
-    if (env > levelStart)
-        levelT = juce::jlimit (0.0f, 1.0f, (env - levelStart) / (levelEnd - levelStart));
+        const int fade = juce::jmin (kPrescanFade, n);
+        auto run = block.getSubBlock ((size_t) runStart, (size_t) n);
 
-    // Baseline even content at SILK 0, more with SILK
-    constexpr float biasTrim = 1.20f;   // +1.6 dB-ish on H2/H4
-    constexpr float biasBase = 0.018f * biasTrim;
-    constexpr float biasSilk = 0.031f * biasTrim;
+        if (runBypass)
+        {
+            // Leaving the OS path: render the fade region through it one last time
+            const bool fadeOut = ! prescanBypassed;
 
-    float targetBias = (biasBase + biasSilk * silkShape) * levelT;
+            if (fadeOut)
+            {
+                auto head = run.getSubBlock (0, (size_t) fade);
+                processOversampledClip (head, cfg);
+                osSamples += fade;
+            }
 
-    // Micro "memory" on bias itself
-    st.biasMemory = analogBiasA * st.biasMemory + (1.0f - analogBiasA) * targetBias;
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float* s         = buffer.getWritePointer (ch, runStart);
+                const float* dry = prescanDry.getReadPointer (ch, kPrescanHistory - prescanLatency + runStart);
 
-    float bias = st.biasMemory;
+                int i = 0;
+                if (fadeOut)
+                {
+                    for (; i < fade; ++i)
+                        s[i] += (dry[i] - s[i]) * ((float) (i + 1) / (float) fade);
+                }
 
-    // Tame bias at insane levels (avoid fuzz)
-    bias *= 1.0f / (1.0f + 0.20f * env);
-    // -------------------------------------------------------------
-    // Bias inside shaper (creates even harmonics)
-    //
-    // IMPORTANT:
-    // We do NOT do (shaped - shaped(bias)) here anymore.
-    // That DC-comp trick was killing the even-harmonic energy.
-    // Instead, we allow the asymmetry to exist, then remove *only DC*
-    // with an ultra-low cutoff one-pole HP (preserves H2/H4/H6).
-    // -------------------------------------------------------------
-    float y = softClip (inRaw, dynamicKnee);
+                for (; i < n; ++i)
+                    s[i] = dry[i];
+            }
 
-    // DC blocker (very low corner) – keeps the expensive even series, removes DC drift
-    st.dcBlock = analogDcAlpha * st.dcBlock + (1.0f - analogDcAlpha) * y;
-    y -= st.dcBlock;
+            prescanBypassed = true;
+        }
+        else
+        {
+            const bool fadeIn = prescanBypassed;
 
-    // Extra HF damping when driven (models converter reconstruction smoothing)
-    st.postLP1 = analogReconA * st.postLP1 + (1.0f - analogReconA) * y;
-    st.postLP2 = analogReconA * st.postLP2 + (1.0f - analogReconA) * st.postLP1;
-    // recon engages strongly once we're truly near the ceiling
-    float reconT = 0.0f;
-    if (env > 0.55f)
-        reconT = juce::jlimit (0.0f, 1.0f, (env - 0.55f) / (1.00f - 0.55f));
+            if (fadeIn)
+                warmUpOversampler (numChannels, runStart);
 
-    float reconBlend = reconT * reconT * reconT;
+            processOversampledClip (run, cfg);
+            osSamples += n;
 
-    // back off HF damping to match hardware "air" at silk=0
-    const float reconBlendBase = juce::jlimit (0.0f, 1.0f, 0.80f * reconBlend);
-    const float sRecon = std::pow (silkShape, 1.56f);
-    constexpr float reconBlendMaxDelta = 0.20f;
-    reconBlend = juce::jlimit (0.0f, 1.0f, reconBlendBase + reconBlendMaxDelta * sRecon);
-    y = y + reconBlend * (st.postLP2 - y);
+            if (fadeIn)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    float* s         = buffer.getWritePointer (ch, runStart);
+                    const float* dry = prescanDry.getReadPointer (ch, kPrescanHistory - prescanLatency + runStart);
 
-    return juce::jlimit (-2.0f, 2.0f, y);
-}
+                    for (int i = 0; i < fade; ++i)
+                        s[i] = dry[i] + (s[i] - dry[i]) * ((float) (i + 1) / (float) fade);
+                }
+            }
 
-float FruityClipAudioProcessor::applyAnalogToneMatch (float x, int channel, float silkAmount)
-{
-    // Safety: bail out if we don't have a valid sample rate or state
-    if (sampleRate <= 0.0)
-        return x;
+            prescanBypassed = false;
+        }
+    };
 
-    if (channel < 0 || channel >= (int) analogToneStates.size())
-        return x;
+    // Decide per segment. A segment counts as hot when it or the next one
+    // reaches the threshold, so within a block the fade-in is over before the
+    // knee is hit; the hold keeps the OS path running past the last hot one.
+    float nextPeak = segmentPeak (0);
 
-    auto& st = analogToneStates[(size_t) channel];
+    for (int start = 0; start < numSamples; start += kPrescanSegment)
+    {
+        const int   n       = juce::jmin (kPrescanSegment, numSamples - start);
+        const float peak    = nextPeak;
+        nextPeak            = (start + n < numSamples) ? segmentPeak (start + n) : 0.0f;
 
-    // -----------------------------------------------------------------
-    // 1) Split into three regions using two one-pole lowpasses:
-    //    low  : below ~250 Hz
-    //    mid  : 250 Hz – ~10 kHz
-    //    high : above ~10 kHz
-    // -----------------------------------------------------------------
-    st.low250 = analogToneAlpha250 * st.low250 + (1.0f - analogToneAlpha250) * x;
-    const float low = st.low250;
+        const bool quiet = juce::jmax (peak, nextPeak) <= threshold;
+        prescanQuietSamples = quiet ? juce::jmin (prescanQuietSamples + n, holdSamples) : 0;
 
-    st.low10k = analogToneAlpha10k * st.low10k + (1.0f - analogToneAlpha10k) * x;
-    const float midPlusLow = st.low10k;
+        const bool bypass = quiet && prescanQuietSamples >= holdSamples;
 
-    const float mid  = midPlusLow - low;
-    const float high = x - midPlusLow;
+        if (bypass != runBypass)
+        {
+            renderRun (start);
+            runStart  = start;
+            runBypass = bypass;
+        }
+    }
 
-    // -----------------------------------------------------------------
-    // 2) Read SILK amount and shape it
-    //
-    // rawSilk comes from the LOVE/SILK knob (0..1). We reuse the same
-    // shaped control curve as the other silk code so the ear feels
-    // consistent: most of the "movement" is towards the top of the knob.
-    // -----------------------------------------------------------------
-    const float s = std::pow (juce::jlimit (0.0f, 1.0f, silkAmount), 0.8f); // shaped SILK control
+    renderRun (numSamples);
 
-    // -----------------------------------------------------------------
-    // 3) 3-band tilt target derived from measurements
-    // -----------------------------------------------------------------
-    const float lowDb  = juce::jmap (s, 0.0f, 1.0f, -0.28f, +0.37f);
-    const float midDb  = juce::jmap (s, 0.0f, 1.0f, -0.31f, +0.45f);
-    const float highDb = juce::jmap (s, 0.0f, 1.0f, -4.72f, -2.77f);
-    const float gainLow  = juce::Decibels::decibelsToGain (lowDb);
-    const float gainMid  = juce::Decibels::decibelsToGain (midDb);
-    const float gainHigh = juce::Decibels::decibelsToGain (highDb);
+    return osSamples;
+}
 
-    // -----------------------------------------------------------------
-    // 4) Apply tilt and clamp
-    // -----------------------------------------------------------------
-    float y = gainLow * low + gainMid * mid + gainHigh * high;
+void FruityClipAudioProcessor::updateOversampleDuty (int oversampledSamples, int numSamples)
+{
+    osDutyOversampled += oversampledSamples;
+    osDutyTotal       += numSamples;
 
-    // Safety clamp – we should never normally hit this,
-    // but it keeps the stage well-behaved in edge cases.
-    return juce::jlimit (-4.0f, 4.0f, y);
+    if (osDutyTotal >= (int) (kOsDutyWindowSeconds * sampleRate))
+    {
+        guiOversampleDuty.store ((float) osDutyOversampled / (float) juce::jmax (1, osDutyTotal));
+        osDutyOversampled = 0;
+        osDutyTotal       = 0;
+    }
 }
 
 //==============================================================
@@ -894,24 +1651,13 @@ void FruityClipAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 {
     juce::ScopedNoDenormals noDenormals;
 
+    const auto blockStartTicks = juce::Time::getHighResolutionTicks();
+
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
 
-    if ((int) kFilterStates.size() < numChannels)
-        resetKFilterState (numChannels);
-    if ((int) satStates.size() < numChannels)
-        resetSatState (numChannels);
-    if ((int) silkStates.size() < numChannels)
-        resetSilkState (numChannels);
-    if ((int) analogToneStates.size() < numChannels)
-        resetAnalogToneState (numChannels);
-    if ((int) analogClipStates.size() < numChannels)
-        resetAnalogClipState (numChannels);
-    if ((int) analogTransientStates.size() < numChannels)
-        resetAnalogTransientState (numChannels);
-
-    if ((int) dsmCaptureEq.filters.size() < numChannels)
-        dsmCaptureEq.prepare (sampleRate, numChannels);
+    // Per-channel stage state is one lane per channel
+    jassert (numChannels <= ChannelLanes::kLanes);
 
     const bool isOffline = isNonRealtime();
 
@@ -936,7 +1682,13 @@ void FruityClipAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     const float killAmount  = juce::jlimit (0.0f, 1.0f, satAmountRaw);
 
     const bool  isAnalogMode     = (clipMode == ClipMode::Analog);
+    const auto  digitalKnee      = (digitalCurve.load() == 1 ? FruityMatch::Curve::polynomial
+                                                             : FruityMatch::Curve::kneeLut);
     const float silkAmountAnalog = marryAmount;
+
+    int adaaOrder = 0;
+    if (auto* adaaParam = parameters.getRawParameterValue ("adaaMode"))
+        adaaOrder = juce::jlimit (0, 2, (int) adaaParam->load());
     const float w = 0.10f * std::pow (juce::jlimit (0.0f, 1.0f, fuckAmount), 2.0f);
 
     // Global scalars for this block
@@ -958,21 +1710,63 @@ void FruityClipAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     if (auto* osModeParam = parameters.getRawParameterValue ("oversampleMode"))
         liveOsIndex = juce::jlimit (0, 6, (int) osModeParam->load());
 
+    // Target-rate mode replaces the plain multiplier with the smallest factor
+    // that reaches the chosen internal rate at this session's sample rate
+    if (auto* targetParam = parameters.getRawParameterValue ("osTargetRate"))
+    {
+        const int targetIndex = juce::jlimit (0, (int) kOsTargetRates.size() - 1, (int) targetParam->load());
+
+        if (targetIndex > 0)
+            liveOsIndex = getOversampleIndexForRate (sampleRate, kOsTargetRates[(size_t) targetIndex]);
+    }
+
     // Start from LIVE value
     int osIndex = liveOsIndex;
 
-    // Offline override: -1 = SAME (follow live), 0..6 = explicit offline choice
+    // Offline override: -1 = SAME (follow live), 0..6 = explicit offline choice,
+    // kOfflinePlanFirst.. = per-region planner (decided after the pre-chain below)
+    int offlinePlanTarget = 0; // 0 = off, else 1-based index into kOfflinePlanAliasDb
+
     if (isOffline)
     {
-        const int offlineIdx = getStoredOfflineOversampleIndex(); // -1..6
-        if (offlineIdx >= 0)
+        const int offlineIdx = getStoredOfflineOversampleIndex(); // -1..8
+
+        if (offlineIdx >= kOfflinePlanFirst)
+            offlinePlanTarget = offlineIdx - kOfflinePlanFirst + 1;
+        else if (offlineIdx >= 0)
             osIndex = offlineIdx;
     }
 
-    // Make sure final index is in range 0..6 for updateOversampling
+    // Make sure final index is in range 0..6 for selectOversampler
     osIndex = juce::jlimit (0, 6, osIndex);
 
+    // Auto: the user's factor is the maximum; realtime playback may run below it
+    bool autoOs = false;
+    if (auto* osAutoParam = parameters.getRawParameterValue ("osAuto"))
+        autoOs = (osAutoParam->load() >= 0.5f) && ! isOffline;
+
+    const int userOsIndex = osIndex;
+
+    if (autoOs)
+        osIndex = juce::jmin (osIndex, autoOsController.ceiling);
+    else
+        autoOsController.reset (kNumOversampleModes - 1); // re-enabling starts from the user's factor
+
+    // Halfband filter row: IIR quality tier (OversamplingQuality: 0=eco, 1=balanced, 2=max)
+    // or the linear-phase FIR, which overrides the tier
+    int osFilter = (int) OversamplingQuality::max;
+    if (auto* osQualityParam = parameters.getRawParameterValue ("osQuality"))
+        osFilter = juce::jlimit (0, kNumOversampleQualities - 1, (int) osQualityParam->load());
+
+    if (auto* linearPhaseParam = parameters.getRawParameterValue ("osLinearPhase"))
+        if (linearPhaseParam->load() > 0.5f)
+            osFilter = kOversampleLinearPhase;
+
     const bool bypassNow = gainBypass.load();
+
+    // Reported latency does not drop while bypassed: delay the dry path to match
+    processBypassDelay (buffer, bypassNow);
+
     if (bypassNow)
     {
         // BYPASS mode: apply only input gain (for loudness-matched A/B).
@@ -992,47 +1786,71 @@ void FruityClipAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     }
     else
     {
-        // Oversampling mode can be changed at runtime – keep Oversampling object in sync
-        if (osIndex != currentOversampleIndex || (! oversampler))
+        // ADAA history is only meaningful for the order and rate it was built at
+        if (adaaOrder != currentAdaaOrder)
         {
-            updateOversampling (osIndex, numChannels);
+            currentAdaaOrder = adaaOrder;
+            resetAdaaState (getTotalNumOutputChannels());
         }
 
-        if (oversampler && maxBlockSize < numSamples)
+        // ANALOG model switch (parameter): its slew / recon corners live in analogRates
+        if (const int model = getAnalogModel(); model != activeAnalogModel)
         {
-            maxBlockSize = numSamples;
-            oversampler->initProcessing ((size_t) maxBlockSize);
+            activeAnalogModel = model;
+            updateAnalogClipperCoefficients();
         }
 
         //==========================================================
         // PRE-CHAIN: GAIN + SILK + DSM capture EQ (base rate)
         //==========================================================
-        for (int ch = 0; ch < numChannels; ++ch)
+
+        // 5060 baseline color even when knob is at 0
+        constexpr float silkBase = 0.15f; // starting point — we will tune after we see numbers
+        const float silkEff = isAnalogMode ? juce::jlimit (0.0f, 1.0f, silkBase + (1.0f - silkBase) * marryAmount)
+                                           : marryAmount;
+
+        silkRamp.setTarget (makeSilkCoeffs (silkEff), numSamples);
+        toneRamp.setTarget (makeToneCoeffs (marryAmount), numSamples);
+
+        // Digital path remains true-bypass when 0 (keeps fruity null), once any ramp down has finished
+        const bool digitalSilkOn = (marryAmount > 0.0f || silkRamp.isRamping());
+
+        const int numLaneChannels = juce::jmin (numChannels, ChannelLanes::kLanes);
+
+        float* channels[ChannelLanes::kLanes] {};
+        for (int ch = 0; ch < numLaneChannels; ++ch)
+            channels[ch] = buffer.getWritePointer (ch);
+
+        // Gain + SILK (+ tone match): every channel per sample, one per lane
+        const auto drive = ChannelLanes::broadcast (inputDrive);
+
+        for (int i = 0; i < numSamples; ++i)
         {
-            float* samples = buffer.getWritePointer (ch);
+            auto s = ChannelLanes::gather (channels, numLaneChannels, i) * drive;
 
-            for (int i = 0; i < numSamples; ++i)
+            if (isAnalogMode)
             {
-                float s = samples[i] * inputDrive;
+                s = applySilkAnalogSample (s, silkRamp.at (i));
 
-                if (isAnalogMode)
-                {
-                    // 5060 baseline color even when knob is at 0
-                    constexpr float silkBase = 0.15f; // starting point — we will tune after we see numbers
-                    const float silkEff = juce::jlimit (0.0f, 1.0f,
-                                                        silkBase + (1.0f - silkBase) * marryAmount);
+                // keep tone-match driven by the knob (0..1) so silk=0 targets your “0 silk” capture curve
+                s = applyAnalogToneMatch (s, toneRamp.at (i));
+            }
+            else if (digitalSilkOn)
+            {
+                s = applySilkAnalogSample (s, silkRamp.at (i));
+            }
 
-                    s = applySilkAnalogSample (s, ch, silkEff);
+            ChannelLanes::scatter (s, channels, numLaneChannels, i);
+        }
 
-                    // keep tone-match driven by the knob (0..1) so silk=0 targets your “0 silk” capture curve
-                    s = applyAnalogToneMatch (s, ch, marryAmount);
-                }
-                else
-                {
-                    // Digital path remains true-bypass when 0 (keeps fruity null)
-                    if (marryAmount > 0.0f)
-                        s = applySilkAnalogSample (s, ch, marryAmount);
-                }
+        // DSM capture EQ (per channel; sized in prepareToPlay, extra channels pass dry)
+        for (int ch = 0; ch < juce::jmin (numChannels, dsmCaptureEq.getNumChannels()); ++ch)
+        {
+            float* samples = buffer.getWritePointer (ch);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float s = samples[i];
 
                 float eq = dsmCaptureEq.processSample (ch, s);
                 s = s + w * (eq - s);
@@ -1046,136 +1864,154 @@ void FruityClipAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         //==========================================================
         const bool limiterOn = useLimiter;
 
-        if (! limiterOn && killAmount > 0.0f)
+        satRamp.setTarget (makeSatCoeffs (killAmount), numSamples);
+
+        if (! limiterOn && (killAmount > 0.0f || satRamp.isRamping()))
         {
             for (int ch = 0; ch < numChannels; ++ch)
             {
                 float* samples = buffer.getWritePointer (ch);
-                auto&  sat     = satStates[(size_t) ch];
+                float& satLow  = laneState.satLow[ch];
 
-                for (int i = 0; i < numSamples; ++i)
-                {
-                    float samplePre = samples[i];
+                // The bass tilt is recursive, the tanh is not: tilt a chunk
+                // into a scratch buffer, then run the tanh over it 4-wide
+                constexpr int kChunk = 64;
+                float driven[kChunk];
 
-                    // --- STATIC INPUT TRIM ---
-                    // At SAT = 0  -> 0 dB
-                    // At SAT = 1  -> ~-0.5 dB
-                    const float inputTrimDb = juce::jmap (killAmount, 0.0f, 1.0f, 0.0f, -0.5f);
-                    const float inputTrim   = juce::Decibels::decibelsToGain (inputTrimDb);
+                for (int start = 0; start < numSamples; start += kChunk)
+                {
+                    const int n = juce::jmin (kChunk, numSamples - start);
 
-                    samplePre *= inputTrim;
+                    for (int j = 0; j < n; ++j)
+                    {
+                        const auto c = satRamp.at (start + j);
 
-                    // --- BASS TILT ---
-                    sat.low = satLowAlpha * sat.low + (1.0f - satLowAlpha) * samplePre;
-                    const float low = sat.low;
+                        // --- STATIC INPUT TRIM ---
+                        const float samplePre = samples[start + j] * c.inputTrim;
 
-                    const float tiltAmount = juce::jmap (killAmount, 0.0f, 1.0f, 0.0f, 0.85f);
-                    const float tilted     = samplePre + tiltAmount * (low - samplePre);
+                        // --- BASS TILT ---
+                        satLow = satLowAlpha * satLow + (1.0f - satLowAlpha) * samplePre;
+                        const float low = satLow;
 
-                    // --- DRIVE ---
-                    const float drive = 1.0f + 5.0f * std::pow (killAmount, 1.3f);
+                        const float tilted = samplePre + c.tilt * (low - samplePre);
 
-                    float driven = std::tanh (tilted * drive);
+                        samples[start + j] = samplePre;
+                        driven[j]          = tilted * c.drive;
+                    }
 
-                    // --- STATIC NORMALISATION (UNITY) ---
-                    const float norm = 1.0f / std::tanh (drive);
-                    driven *= norm;
+                    // --- DRIVE ---
+                    FastMath::tanhBlock (driven, n);
 
-                    // --- DRY/WET ---
-                    const float mix = std::pow (killAmount, 1.0f);
-                    float sample    = samplePre + mix * (driven - samplePre);
+                    for (int j = 0; j < n; ++j)
+                    {
+                        const auto c = satRamp.at (start + j);
+                        const float samplePre = samples[start + j];
 
-                    samples[i] = sample;
+                        // --- STATIC NORMALISATION (UNITY) + DRY/WET ---
+                        samples[start + j] = samplePre + c.mix * (driven[j] * c.norm - samplePre);
+                    }
                 }
             }
         }
 
         //==========================================================
-        // DISTORTION CHAIN (CLIP or LIMITER)
-        //   - In oversampled mode, this runs at higher rate
-        //   - No metering here; meters are computed later at base rate
+        // OFFLINE PLANNER: factor for this region from its clip-stage input
         //==========================================================
-
-        // Compute DC-block coefficient for the analog clipper at the *current processing rate*.
-        // When oversampling is on, applyClipperAnalogSample runs at the oversampled rate.
-        // We want a ~sub-5 Hz corner no matter what.
+        if (offlinePlanTarget > 0)
         {
-            float effectiveSr = (float) sampleRate;
-            if (oversampler && currentOversampleIndex > 0)
-                effectiveSr *= (float) oversampler->getOversamplingFactor();
-
-            // Ultra-low DC cutoff (Hz)
-            constexpr float dcFc = 3.0f;
-            analogDcAlpha = std::exp (-2.0f * juce::MathConstants<float>::pi * dcFc / juce::jmax (1.0f, effectiveSr));
-            analogDcAlpha = juce::jlimit (0.0f, 0.9999999f, analogDcAlpha);
+            const float clipThreshold = isAnalogMode ? 1.0f : FruityMatch::kKneeStart;
+            const int   minIndex      = isAnalogMode ? 1 : 0; // Analog is never the identity
+
+            int planned = planOversampleIndex (buffer, clipThreshold,
+                                               kOfflinePlanAliasDb[(size_t) (offlinePlanTarget - 1)]);
+            planned = juce::jmax (planned, minIndex);
+
+            // Step up at once; step down only once the region has needed less for a while
+            if (planned >= currentOversampleIndex)
+            {
+                planHoldSamples = (int) (kPlanHoldSeconds * sampleRate);
+                osIndex = planned;
+            }
+            else if (planHoldSamples > 0)
+            {
+                planHoldSamples -= numSamples;
+                osIndex = currentOversampleIndex;
+            }
+            else
+            {
+                planHoldSamples = (int) (kPlanHoldSeconds * sampleRate);
+                osIndex = planned;
+            }
         }
 
-        const bool useOversampling = (oversampler != nullptr && currentOversampleIndex > 0);
+        // Oversampling mode / filter can be changed at runtime – switch to the prepared
+        // bank entry and crossfade from the previous one over the next block.
+        // (the filter row only matters when actually oversampling)
+        const bool osFilterChanged = (osFilter != currentOversampleFilter)
+                                  && (osIndex > 0 || currentOversampleIndex > 0);
 
-        if (useOversampling)
+        if (osIndex != currentOversampleIndex || osFilterChanged)
         {
-            juce::dsp::AudioBlock<float> block (buffer);
+            autoOsController.hold (sampleRate); // let the load settle
+            osSwitchFromIndex  = currentOversampleIndex;
+            osSwitchFromFilter = currentOversampleFilter;
+            selectOversampler (osIndex, osFilter);
+
+            if (oversampler != nullptr)
+                oversampler->reset();
+        }
+        else if (osFilter != currentOversampleFilter)
+        {
+            currentOversampleFilter = osFilter; // x1: nothing to switch
+        }
 
-            auto osBlock      = oversampler->processSamplesUp (block);
-            const int osNumSamples  = (int) osBlock.getNumSamples();
-            const int osNumChannels = (int) osBlock.getNumChannels(); // should match numChannels
+        // Reported latency: a factor the user picks reports its own (FIR and IIR
+        // differ). The planner's factors are padded to the largest it may pick –
+        // set in prepareToPlay and constant through the render – and Auto's steps
+        // to the user's factor, so the host's delay compensation never moves
+        // under a bounce or during playback.
+        {
+            const int automaticCeiling = (offlinePlanTarget > 0) ? kNumOversampleModes - 1
+                                       : (autoOs ? userOsIndex : -1);
+            const int target = getClipLatencyTarget (currentOversampleFilter, currentOversampleIndex, automaticCeiling);
 
-            for (int ch = 0; ch < osNumChannels; ++ch)
+            if (target != clipLatencyTarget)
             {
-                float* samples = osBlock.getChannelPointer (ch);
+                clipLatencyTarget = target;
+                updateReportedLatency();
+            }
+        }
 
-                for (int i = 0; i < osNumSamples; ++i)
-                {
-                    float sample = samples[i];
+        //==========================================================
+        // DISTORTION CHAIN (CLIP or LIMITER)
+        //   - In oversampled mode, this runs at higher rate
+        //   - No metering here; meters are computed later at base rate
+        //==========================================================
 
-                    if (limiterOn)
-                    {
-                        sample = processLimiterSample (sample);
-                    }
-                    else if (isAnalogMode)
-                    {
-                        sample = applyClipperAnalogSample (sample, ch, silkAmountAnalog);
-                    }
-                    else
-                    {
-                        // DIGITAL clip (Fruity Clipper curve)
-                        sample = fruityClipperDigital (sample);
-                    }
+        // A factor switch still crossfades from the previous factor's output
+        const bool useOversampling = (oversampler != nullptr || osSwitchFromIndex > 0);
 
-                    samples[i] = sample;
-                }
-            }
+        ClipStageConfig clipCfg;
+        clipCfg.limiterOn   = limiterOn;
+        clipCfg.analogMode  = isAnalogMode;
+        clipCfg.digitalPoly = (digitalKnee == FruityMatch::Curve::polynomial);
+        clipCfg.analogClip  = makeAnalogClipCoeffs (silkAmountAnalog);
+        clipCfg.adaaOrder   = adaaOrder;
 
-            // Downsample once for the whole block.
-            oversampler->processSamplesDown (block);
-        }
-        else
-        {
-            //======================================================
-            // NO OVERSAMPLING – process at base rate only
-            //======================================================
-            for (int ch = 0; ch < numChannels; ++ch)
-            {
-                float* samples = buffer.getWritePointer (ch);
+        // Plain (non-ADAA) DIGITAL is the identity below the knee; ADAA is not
+        // (it averages neighbouring samples), so the sub-knee shortcuts are off.
+        const bool subKneeIsIdentity = (! limiterOn && ! isAnalogMode && adaaOrder == 0);
 
-                for (int i = 0; i < numSamples; ++i)
-                {
-                    float sample = samples[i];
-
-                    // SAT already applied previously if needed.
-                    if (limiterOn)
-                        sample = processLimiterSample (sample);
-                    else if (isAnalogMode)
-                        sample = applyClipperAnalogSample (sample, ch, silkAmountAnalog);
-                    else
-                    {
-                        // DIGITAL clip (Fruity Clipper curve)
-                        sample = fruityClipperDigital (sample);
-                    }
+        // The oversamplers are prepared for maxBlockSize; larger host blocks
+        // are split rather than re-initialised on the audio thread.
+        const int chunkSize = juce::jmax (1, maxBlockSize);
 
-                    samples[i] = sample;
-                }
-            }
+        for (int start = 0; start < numSamples; start += chunkSize)
+        {
+            const int n = juce::jmin (chunkSize, numSamples - start);
+            juce::AudioBuffer<float> chunk (buffer.getArrayOfWritePointers(), numChannels, start, n);
+
+            processClipChunk (chunk, clipCfg, subKneeIsIdentity);
         }
 
         // FINAL SAFETY CEILING AT BASE RATE
@@ -1199,6 +2035,25 @@ void FruityClipAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             }
         }
 
+        // TRUE-PEAK CEILING (base rate, look-ahead)
+        // Only where the 4x estimate exceeds the ceiling does the gain drop below 1.
+        int tpCeiling = 0;
+        if (auto* tpParam = parameters.getRawParameterValue ("tpCeiling"))
+            tpCeiling = juce::jlimit (0, (int) kTpCeilingDb.size() - 1, (int) tpParam->load());
+
+        if (tpCeiling != currentTpCeiling)
+        {
+            if (currentTpCeiling == 0)
+                truePeakLimiter.reset(); // stale look-ahead from the last time it was on
+
+            currentTpCeiling = tpCeiling;
+            truePeakLimiter.setCeilingDb (kTpCeilingDb[(size_t) tpCeiling]);
+            updateReportedLatency();
+        }
+
+        if (currentTpCeiling > 0)
+            truePeakLimiter.process (buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
         // Do not quantize/dither in Fruity DIGITAL mode (must stay float to null).
         if (useLimiter || isAnalogMode)
         {
@@ -1267,37 +2122,53 @@ void FruityClipAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     double sumSquaresK   = 0.0;
     const  int totalSamplesK = juce::jmax (1, numSamples * juce::jmax (1, numChannels));
 
-    for (int ch = 0; ch < numChannels; ++ch)
     {
-        float* samples = buffer.getWritePointer (ch);
-        auto&  kf      = kFilterStates[(size_t) ch];
+        // All channels per sample, one per lane
+        using namespace ChannelLanes;
+
+        const int numMeterChannels = juce::jmin (numChannels, kLanes);
+
+        float* channels[kLanes] {};
+        for (int ch = 0; ch < numMeterChannels; ++ch)
+            channels[ch] = buffer.getWritePointer (ch);
+
+        Vec z1a = load (laneState.kZ1a), z2a = load (laneState.kZ2a);
+        Vec z1b = load (laneState.kZ1b), z2b = load (laneState.kZ2b);
+        Vec peak = broadcast (0.0f);
 
         for (int i = 0; i < numSamples; ++i)
         {
-            float y = samples[i];
+            const Vec y = gather (channels, numMeterChannels, i);
 
             // Track peak for GUI burn + gating
-            const float ay = std::abs (y);
-            if (ay > blockMax)
-                blockMax = ay;
+            peak = max (peak, abs (y));
 
             // --- K-weighted meter path ---
-            float xk = y;
-
             // Stage 1
-            float v1 = xk - k_a1a * kf.z1a - k_a2a * kf.z2a;
-            float y1 = k_b0a * v1 + k_b1a * kf.z1a + k_b2a * kf.z2a;
-            kf.z2a = kf.z1a;
-            kf.z1a = v1;
+            const Vec v1 = y - broadcast (k_a1a) * z1a - broadcast (k_a2a) * z2a;
+            const Vec y1 = broadcast (k_b0a) * v1 + broadcast (k_b1a) * z1a + broadcast (k_b2a) * z2a;
+            z2a = z1a;
+            z1a = v1;
 
             // Stage 2
-            float v2 = y1 - k_a1b * kf.z1b - k_a2b * kf.z2b;
-            float y2 = k_b0b * v2 + k_b1b * kf.z1b + k_b2b * kf.z2b;
-            kf.z2b = kf.z1b;
-            kf.z1b = v2;
-
-            sumSquaresK += (double) (y2 * y2);
+            const Vec v2 = y1 - broadcast (k_a1b) * z1b - broadcast (k_a2b) * z2b;
+            const Vec y2 = broadcast (k_b0b) * v2 + broadcast (k_b1b) * z1b + broadcast (k_b2b) * z2b;
+            z2b = z1b;
+            z1b = v2;
+
+            Array squares;
+            store (y2 * y2, squares);
+            for (int ch = 0; ch < numMeterChannels; ++ch)
+                sumSquaresK += (double) squares[ch];
         }
+
+        store (z1a, laneState.kZ1a);  store (z2a, laneState.kZ2a);
+        store (z1b, laneState.kZ1b);  store (z2b, laneState.kZ2b);
+
+        Array peaks;
+        store (peak, peaks);
+        for (int ch = 0; ch < numMeterChannels; ++ch)
+            blockMax = juce::jmax (blockMax, peaks[ch]);
     }
 
     //==========================================================
@@ -1427,6 +2298,17 @@ void FruityClipAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     // That way, our LUFS readout tracks Youlean/MiniMeters closely,
     // while the LOOK/BURN animation can stay lazy / vibey.
     guiLufs.store (lufs);
+
+    guiOversampleIndex.store (currentOversampleIndex);
+
+    if (autoOs && ! bypassNow)
+        updateAutoOversample (blockStartTicks, numSamples, userOsIndex);
+}
+
+void FruityClipAudioProcessor::updateAutoOversample (juce::int64 blockStartTicks, int numSamples, int userOsIndex)
+{
+    const double elapsed = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - blockStartTicks);
+    autoOsController.update (elapsed, numSamples, sampleRate, userOsIndex);
 }
 
 //==============================================================
@@ -1,9 +1,21 @@
 #pragma once
 
 #include "JuceHeader.h"
+#include "AnalogEngine.h"
+#include "AutoOversample.h"
+#include "ChannelLanes.h"
+#include "ClipLatency.h"
+#include "ChannelWorker.h"
+#include "ControlRamp.h"
+#include "DsmCaptureFit.h"
+#include "TruePeakLimiter.h"
+#include <array>
 #include <atomic>
 #include <vector>
 
+namespace FruityMatch { struct AdaaState; }
+class OversamplingEngine;
+
 class FruityClipAudioProcessor : public juce::AudioProcessor
 {
 public:
@@ -73,6 +85,13 @@ public:
     // True if we currently have enough signal to show LUFS
     bool getGuiHasSignal() const { return guiSignalEnv.load() > 0.2f; }
 
+    // 0..1 share of recent clip-stage samples that went through the oversampler
+    float getOversampleDutyCycle() const { return guiOversampleDuty.load(); }
+
+    // Oversample index actually in use (0 = x1 .. 6 = x64); differs from the
+    // parameter in Auto mode
+    int getActiveOversampleIndex() const { return guiOversampleIndex.load(); }
+
     ClipMode getClipMode() const;
     bool isLimiterEnabled() const;
 
@@ -89,7 +108,12 @@ public:
     int getStoredLookMode() const;
     void setStoredLookMode (int modeIndex);
 
-    // Offline oversample index
+    // Offline oversample index: -1 = SAME, 0..6 = x1..x64,
+    // kOfflinePlanFirst.. = per-region planner at kOfflinePlanAliasDb
+    static constexpr int kOfflinePlanFirst = 7;
+    static constexpr int kOfflineIndexLast = 8;
+    static constexpr std::array<float, 2> kOfflinePlanAliasDb { -60.0f, -80.0f };
+
     int  getStoredOfflineOversampleIndex() const;
     void setStoredOfflineOversampleIndex (int index);
 
@@ -97,6 +121,23 @@ public:
     int  getStoredLiveOversampleIndex() const;
     void setStoredLiveOversampleIndex (int index);
 
+    // DIGITAL knee evaluator (global): 0 = compact LUT, 1 = polynomial
+    int  getStoredDigitalCurve() const;
+    void setStoredDigitalCurve (int index);
+
+    // Multi-core oversampling (global): second channel of the x32 / x64 clip stage on a worker
+    bool getStoredMultiCore() const;
+    void setStoredMultiCore (bool shouldUseWorker);
+
+    // ANALOG model: the "analogModel" parameter (per session), an index into
+    // AnalogEngine::kVariants, 0 = knee, 1 = hard, 2 = knee table. Setting it
+    // also makes it the global default for new instances (stored below).
+    int  getAnalogModel() const;
+    void setAnalogModel (int model);
+
+    int  getStoredAnalogModel() const;
+    void setStoredAnalogModel (int model);
+
     // Bypass all processing after input gain (for A/B)
     void setGainBypass (bool shouldBypass)        { gainBypass.store (shouldBypass); }
     bool getGainBypass() const                    { return gainBypass.load(); }
@@ -113,125 +154,188 @@ private:
     // Limiter sample processor
     float processLimiterSample (float x);
 
-    float applySilkPreEmphasis  (float x, int channel, float silkAmount);
-    float applySilkDeEmphasis   (float x, int channel, float silkAmount);
-
-    // SILK color stage at base rate, pre-clip
-    float applySilkAnalogSample (float x, int channel, float silkAmount);
-
-    // Analog “Lavry-ish” clipper in oversampled domain
-    float applyClipperAnalogSample (float x, int channel, float silkAmount);
-
-    // Analog tone-match tilt, post-clip, back at base rate or in the oversampled block
-    float applyAnalogToneMatch (float x, int channel, float silkAmount);
-
     //==========================================================
-    // K-weighted LUFS meter state
+    // Control-rate coefficients
+    //   Everything the SILK / tone / SAT / analog-clip sample code derives
+    //   from the knobs, computed once per block by make*Coeffs() instead of
+    //   per sample (pow / exp / dB conversions). The base-rate stages ramp
+    //   them across the block with ControlRamp; the analog clipper holds
+    //   them for the block.
     //==========================================================
-    struct KFilterState
+    struct SilkCoeffs
     {
-        float z1a = 0.0f;
-        float z2a = 0.0f;
-        float z1b = 0.0f;
-        float z2b = 0.0f;
+        float preAlpha  = 0.0f;  // pre-emphasis one-pole
+        float preTilt   = 0.0f;
+        float deAlpha   = 0.0f;  // de-emphasis one-pole
+        float deBlend   = 0.0f;
+        float evenScale = 0.0f;  // even coefficient per driveT (model's EvenLaw); 0 = even term off
+        float evenCap   = 0.0f;
     };
 
-    void resetKFilterState (int numChannels);
-
-    std::vector<KFilterState> kFilterStates;
-    float lufsMeanSquare = 1.0e-6f;  // keep > 0 to avoid log(0)
-    float lufsAverageLufs = -60.0f;  // slow (~2s) averaged LUFS in dB for LOOK = LUFS burn
+    struct ToneCoeffs
+    {
+        float gainLow  = 1.0f;
+        float gainMid  = 1.0f;
+        float gainHigh = 1.0f;
+    };
 
-    struct SilkState
+    struct SatCoeffs
     {
-        float pre    = 0.0f;
-        float de     = 0.0f;
-        float evenDc = 0.0f; // DC tracker for quadratic (even-harmonic) term
+        float inputTrim = 1.0f;
+        float tilt      = 0.0f;
+        float drive     = 1.0f;
+        float norm      = 1.0f;  // 1 / tanh (drive)
+        float mix       = 0.0f;
     };
 
-    void resetSilkState (int numChannels);
+    using AnalogClipCoeffs = AnalogEngine::ClipCoeffs;
 
-    std::vector<SilkState> silkStates;
+    SilkCoeffs       makeSilkCoeffs (float silkAmount) const;
+    static ToneCoeffs makeToneCoeffs (float silkAmount);
+    static SatCoeffs  makeSatCoeffs (float satAmount);
+    AnalogClipCoeffs makeAnalogClipCoeffs (float silkAmount) const;
 
-    float silkEvenDcAlpha = 0.0f; // DC servo coeff for quadratic even term (base rate)
+    ControlRamp<SilkCoeffs> silkRamp;
+    ControlRamp<ToneCoeffs> toneRamp;
+    ControlRamp<SatCoeffs>  satRamp;
 
-    //==========================================================
-    // SAT bass-tilt state (for gradual TikTok bass boost)
-    //==========================================================
-    struct SatState
-    {
-        float low = 0.0f;   // lowpassed state for bass emphasis
-    };
+    // Per-sample stages below process every channel at once, one per lane
+    using LaneVec = ChannelLanes::Vec;
 
-    void resetSatState (int numChannels);
+    LaneVec applySilkPreEmphasis  (LaneVec x, const SilkCoeffs& c);
+    LaneVec applySilkDeEmphasis   (LaneVec x, const SilkCoeffs& c);
 
-    std::vector<SatState> satStates;
-    float satLowAlpha = 0.0f;    // one-pole LP factor for SAT bass tilt
+    // SILK color stage at base rate, pre-clip
+    LaneVec applySilkAnalogSample (LaneVec x, const SilkCoeffs& c);
+
+    // Analog tone-match tilt, post-clip, back at base rate or in the oversampled block
+    LaneVec applyAnalogToneMatch (LaneVec x, const ToneCoeffs& c);
 
     //==========================================================
-    // Analog tone-match state (for 0-silk 5060->Lavry match)
+    // Per-channel state of the per-sample stages, struct-of-arrays:
+    // every field holds one lane per channel (see ChannelLanes.h), so a
+    // stage updates all channels with one vector op. Fixed size – no
+    // allocation, no per-channel bounds checks (layouts are mono / stereo).
     //==========================================================
-    struct AnalogToneState
+    using LaneArray = ChannelLanes::Array;
+
+    struct ChannelLaneState
     {
-        float low250 = 0.0f; // lowpassed state for ~250 Hz split
-        float low10k = 0.0f; // lowpassed state for ~10 kHz split
-    };
+        // SILK pre / de-emphasis + DC tracker for the quadratic (even-harmonic) term
+        LaneArray silkPre, silkDe, silkEvenDc;
 
-    void resetAnalogToneState (int numChannels);
+        // SAT bass tilt (for gradual TikTok bass boost)
+        LaneArray satLow;
 
-    std::vector<AnalogToneState> analogToneStates;
-    float analogToneAlpha250 = 0.0f;    // one-pole LP factor for ~250 Hz split
-    float analogToneAlpha10k = 0.0f;    // one-pole LP factor for ~10 kHz split
-    float analogEnvAttackAlpha  = 0.0f; // envelope follower for analog bias
-    float analogEnvReleaseAlpha = 0.0f;
-    float analogDcAlpha         = 0.0f; // DC blocker coefficient for analog clipper (computed per-block for OS rate)
-    float analogReconA          = 0.0f; // post-clip reconstruction smoothing
+        // Analog tone match (0-silk 5060->Lavry): ~250 Hz and ~10 kHz splits
+        LaneArray toneLow250, toneLow10k;
 
-    struct AnalogTransientState
-    {
-        float fastEnv = 0.0f;
-        float slowEnv = 0.0f;
-        float slew    = 0.0f;
-        float prev    = 0.0f;
+        // K-weighted LUFS meter, two biquads
+        LaneArray kZ1a, kZ2a, kZ1b, kZ2b;
     };
 
-    void resetAnalogTransientState (int numChannels);
+    ChannelLaneState laneState;
 
-    std::vector<AnalogTransientState> analogTransientStates;
-    float analogFastEnvA = 0.0f;
-    float analogSlowEnvA = 0.0f;
-    float analogSlewA    = 0.0f;
-    float analogBiasA    = 0.0f;
+    void resetKFilterState();
+    void resetSilkState();
+    void resetSatState();
+    void resetAnalogToneState();
+
+    float lufsMeanSquare = 1.0e-6f;  // keep > 0 to avoid log(0)
+    float lufsAverageLufs = -60.0f;  // slow (~2s) averaged LUFS in dB for LOOK = LUFS burn
+
+    float silkEvenDcAlpha = 0.0f; // DC servo coeff for quadratic even term (base rate)
+    float satLowAlpha     = 0.0f; // one-pole LP factor for SAT bass tilt
+
+    float analogToneAlpha250 = 0.0f;    // one-pole LP factor for ~250 Hz split
+    float analogToneAlpha10k = 0.0f;    // one-pole LP factor for ~10 kHz split
+    AnalogEngine::Rates analogRates;    // analog clipper, for the active model and factor
 
     struct DsmCaptureEq
     {
-        static constexpr int kNumBands = 32;
+        static constexpr int kNumBands = DsmCaptureFit::kCaptureBands;
+
+        // Order-reduced cascade (DsmCaptureFit.h), refitted when the rate changes:
+        // the fewest sections within kFitToleranceDb of the band cascade, which
+        // stays as the reference and runs when no fit is close enough
+        static constexpr int    kMinFitSections = 4;
+        static constexpr int    kMaxFitSections = 6;
+        static constexpr double kFitToleranceDb = 0.25;
 
+        // Message thread: fits (once per rate), builds the shared coefficients and
+        // the filter state for numChannels channels (the audio thread never resizes)
         void prepare (double sampleRate, int numChannels)
         {
             sr = sampleRate;
-            filters.clear();
-            filters.resize ((size_t) numChannels);
 
-            for (int ch = 0; ch < numChannels; ++ch)
+            if (sampleRate != fittedRate)
             {
-                filters[(size_t) ch].clear();
-                filters[(size_t) ch].reserve (kNumBands);
+                DsmCaptureFit::Section bands[kNumBands];
+                DsmCaptureFit::captureReference (bands);
+
+                fit = DsmCaptureFit::fitWithin (bands, kNumBands, sampleRate,
+                                                kMinFitSections, kMaxFitSections, kFitToleranceDb);
+                fittedRate = sampleRate;
+            }
+
+            coefficients.clear();
+
+            if (fit.maxErrorDb <= kFitToleranceDb)
+            {
+                coefficients.reserve ((size_t) fit.numSections);
+
+                // Flat gain rides on the first section's numerator
+                const double g = std::pow (10.0, fit.gainDb / 20.0);
+
+                for (int i = 0; i < fit.numSections; ++i)
+                {
+                    const auto c = DsmCaptureFit::coefficients (fit.sections[i], sr);
+                    const double b = (i == 0) ? g : 1.0;
+
+                    coefficients.push_back (new juce::dsp::IIR::Coefficients<float> ((float) (b * c.b0), (float) (b * c.b1), (float) (b * c.b2),
+                                                                                     1.0f, (float) c.a1, (float) c.a2));
+                }
+            }
+            else
+            {
+                coefficients.reserve (kNumBands);
 
                 for (int i = 0; i < kNumBands; ++i)
                 {
-                    juce::dsp::IIR::Filter<float> f;
-                    const float fc = kCentersHz[i];
+                    const float fc = DsmCaptureFit::kCaptureCentersHz[i];
                     const float Q  = 1.0f;
-                    const float g  = juce::Decibels::decibelsToGain (kGainDb[i]);
+                    const float g  = juce::Decibels::decibelsToGain (DsmCaptureFit::kCaptureGainDb[i]);
 
-                    auto coeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter ((double) sr, (double) fc, (double) Q, (double) g);
-                    f.coefficients = coeffs;
-                    filters[(size_t) ch].push_back (std::move (f));
+                    coefficients.push_back (juce::dsp::IIR::Coefficients<float>::makePeakFilter ((double) sr, (double) fc, (double) Q, (double) g));
                 }
             }
+
+            filters.clear();
+            setNumChannels (numChannels);
         }
 
+        // Per-channel state only (no fit, no coefficient design); allocates
+        void setNumChannels (int numChannels)
+        {
+            filters.resize ((size_t) numChannels);
+
+            for (auto& chain : filters)
+            {
+                if (chain.size() == coefficients.size())
+                    continue;
+
+                chain.resize (coefficients.size());
+
+                for (size_t i = 0; i < chain.size(); ++i)
+                {
+                    chain[i].coefficients = coefficients[i];
+                    chain[i].reset();
+                }
+            }
+        }
+
+        int getNumChannels() const noexcept { return (int) filters.size(); }
+
         float processSample (int ch, float x) noexcept
         {
             float y = x;
@@ -243,79 +347,10 @@ private:
 
         double sr = 48000.0;
 
-        // 32 log-spaced centers, 30 Hz..16 kHz
-        static constexpr float kCentersHz[kNumBands] =
-        {
-            33.092579f,
-            40.267004f,
-            48.996835f,
-            59.619282f,
-            72.544660f,
-            88.274275f,
-            107.414574f,
-            130.703420f,
-            159.041830f,
-            193.508035f,
-            235.460310f,
-            286.507782f,
-            348.616731f,
-            424.190115f,
-            516.150857f,
-            628.044838f,
-            764.213258f,
-            929.914611f,
-            1131.559314f,
-            1376.941131f,
-            1675.545405f,
-            2038.935964f,
-            2481.168518f,
-            3019.339094f,
-            3674.254166f,
-            4470.574843f,
-            5439.007361f,
-            6616.045966f,
-            8047.239269f,
-            9788.571933f,
-            11907.160373f,
-            14484.677393f
-        };
-
-        // Static capture curve (dB) extracted from your dry vs DSM@10% exports (Song 1+2 averaged, smoothed)
-        static constexpr float kGainDb[kNumBands] =
-        {
-            0.760310f,
-            0.000000f,
-            0.810142f,
-            0.860032f,
-            0.911617f,
-            0.987374f,
-            1.082699f,
-            1.183147f,
-            1.301452f,
-            1.465170f,
-            1.554878f,
-            1.552840f,
-            1.570643f,
-            1.567540f,
-            1.608158f,
-            1.651806f,
-            1.683060f,
-            1.750147f,
-            1.842836f,
-            1.982185f,
-            2.148078f,
-            2.376799f,
-            2.646037f,
-            2.927008f,
-            3.152581f,
-            3.302534f,
-            3.377938f,
-            3.488114f,
-            3.564036f,
-            4.178587f,
-            4.352958f,
-            4.352958f
-        };
+        double             fittedRate = 0.0;
+        DsmCaptureFit::Fit fit;   // for fittedRate; maxErrorDb above tolerance = reference cascade
+
+        std::vector<juce::dsp::IIR::Coefficients<float>::Ptr> coefficients;   // shared by every channel
 
         std::vector<std::vector<juce::dsp::IIR::Filter<float>>> filters;
     };
@@ -324,20 +359,22 @@ private:
 
 
     //==========================================================
-    // Analog clipper state (per channel, for bias memory)
+    // Analog clipper state (lanes = channels), saved around factor switches
     //==========================================================
-    struct AnalogClipState
-    {
-        float biasMemory = 0.0f;
-        float levelEnv   = 0.0f; // slow envelope of |in| for bias engagement
-        float dcBlock    = 0.0f; // ultra-low HP state to remove DC without killing even harmonics
-        float postLP1    = 0.0f; // post-clip HF damping state (pole 1)
-        float postLP2    = 0.0f; // post-clip HF damping state (pole 2)
-    };
+    using AnalogClipLaneState = AnalogEngine::State;
 
-    void resetAnalogClipState (int numChannels);
+    void resetAnalogClipState();
 
-    std::vector<AnalogClipState> analogClipStates;
+    AnalogClipLaneState analogClipLanes;
+
+    //==========================================================
+    // DIGITAL clipper ADAA history (see FruityMatchADAA.h; the ANALOG
+    // knee keeps its own in AnalogClipLaneState::kneeX1)
+    //==========================================================
+    void resetAdaaState (int numChannels);
+
+    std::vector<FruityMatch::AdaaState> adaaStates;
+    int currentAdaaOrder = 0;  // 0 = off, 1 / 2 = antiderivative order
 
     //==========================================================
     // Internal state
@@ -362,6 +399,12 @@ private:
     // GUI signal envelope (0..1) for gating the LUFS display
     std::atomic<float> guiSignalEnv { 0.0f };
 
+    // GUI oversampler duty cycle (0..1), published every kOsDutyWindowSeconds
+    std::atomic<float> guiOversampleDuty { 0.0f };
+
+    // GUI oversample index in use
+    std::atomic<int> guiOversampleIndex { 0 };
+
     // When true, only input gain is applied; OTT/SAT/limiter/oversampling/metering are bypassed
     std::atomic<bool> gainBypass { false };
 
@@ -381,16 +424,219 @@ private:
     //       from userSettings or used as a global default for new instances.
     int  storedLiveOversampleIndex = 0;
 
+    // DIGITAL knee evaluator, read on the audio thread (see FruityMatch::Curve)
+    std::atomic<int> digitalCurve { 0 };
+
+    // Multi-core oversampling preference, read on the audio thread
+    std::atomic<bool> multiCore { false };
+
+    // ANALOG model the clipper runs; follows the "analogModel" parameter at the next block
+    int activeAnalogModel = 0;
+
     //==========================================================
     // Oversampling
+    //   Every factor is built in prepareToPlay. The audio thread only moves
+    //   the active pointer and crossfades one block from the old factor:
+    //   the new one is pre-rolled on the input history first, and the old
+    //   output is delay-aligned to the new latency for the fade.
+    //   Factors the processor picks by itself (offline planner, Auto)
+    //   are padded to the largest latency it may pick (ClipLatency.h),
+    //   so the reported latency only moves on a user change.
     //==========================================================
-    std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
+    static constexpr int kNumOversampleModes = 7;   // x1..x64
+    static constexpr int kOsSwitchFade       = 256; // base-rate samples
+
+    // Oversampled samples per channel processed per up -> clip -> down pass
+    // (32 KB of float per channel at the top rate; fits L2 with all stages).
+    static constexpr int kOsWorkingSetSamples = 8192;
+
+    // Filter rows of the bank: the IIR quality tiers, then the linear-phase FIR
+    static constexpr int kNumOversampleQualities  = 3;                           // OversamplingQuality: eco, balanced, max
+    static constexpr int kOversampleLinearPhase   = kNumOversampleQualities;     // FIR equiripple, max quality
+    static constexpr int kNumOversampleFilters    = kNumOversampleQualities + 1;
+
+    // [filter][osIndex]; [*][0] (x1) stays null
+    std::array<std::array<std::unique_ptr<OversamplingEngine>, kNumOversampleModes>, kNumOversampleFilters> oversamplerBank;
+    OversamplingEngine* oversampler = nullptr;  // active bank entry, null at x1
     int currentOversampleIndex = 0;   // 0=x1, 1=x2, 2=x4, 3=x8, 4=x16, 5=x32, 6=x64
+    int currentOversampleFilter = 2;  // bank row: 0..2 = IIR quality tier, 3 = linear phase
     int currentOversampleFactor = 1;  // 1,2,4,8,16,32,64 (derived from index)
-    int maxBlockSize           = 0;   // for oversampler->initProcessing
+    int maxBlockSize           = 0;   // prepared block size; larger host blocks are processed in chunks
+    int oversampleSubBlock     = 1;   // base-rate sub-block of the active factor
+
+    std::array<int, kNumOversampleModes> oversampleSubBlocks {}; // per factor, set in prepareOversamplerBank
+
+    // [filter][osIndex] integer latency in base-rate samples, set in prepareOversamplerBank
+    std::array<std::array<int, kNumOversampleModes>, kNumOversampleFilters> oversampleLatencies {};
+
+    juce::AudioBuffer<float> osSwitchScratch;  // old-factor render during a switch
+    int osSwitchFromIndex   = -1;              // >= 0: next chunk crossfades from this factor
+    int osSwitchFromFilter  = 2;               //        ... and this filter row
+
+    //==========================================================
+    // Auto oversampling (realtime only)
+    //   The chosen factor becomes a ceiling. processBlock's wall time
+    //   against the block deadline steps the live factor down when
+    //   over budget, and back up when the next factor (about twice
+    //   the cost) would still fit (AutoOversample.h). Steps go through
+    //   the bank switch crossfade and are padded to the user's factor's
+    //   latency, which is what gets reported; offline renders always
+    //   use the full factor.
+    //==========================================================
+    AutoOversample::Controller autoOsController;
+
+    void updateAutoOversample (juce::int64 blockStartTicks, int numSamples, int userOsIndex);
+
+    // Target internal rate mode ("osTargetRate"): [0] = off, use the factor
+    static constexpr std::array<double, 5> kOsTargetRates { 0.0, 176400.0, 352800.0, 705600.0, 1411200.0 };
+
+    // Smallest oversample index (factor 2^index) with sampleRate * factor >= targetRate
+    static int getOversampleIndexForRate (double baseRate, double targetRate) noexcept;
+
+    //==========================================================
+    // Offline planner
+    //   Each region (processBlock call) is analysed at base rate
+    //   just before the clip stage and rendered at the smallest
+    //   factor whose estimated alias level meets the target; the
+    //   bank switch crossfades at the boundaries.
+    //==========================================================
+    static constexpr float kPlanHoldSeconds = 0.25f;  // before stepping the factor back down
+
+    int planHoldSamples = 0;
+
+    int planOversampleIndex (const juce::AudioBuffer<float>& buffer, float clipThreshold, float aliasTargetDb) const;
 
-    void updateOversampling (int osIndex, int numChannels);
+    void prepareOversamplerBank (int numChannels);
+    void selectOversampler (int osIndex, int filter);
     void updateAnalogClipperCoefficients();
 
+    //==========================================================
+    // Clip stage (runs at base rate or inside the oversampler)
+    //==========================================================
+    struct ClipStageConfig
+    {
+        bool  limiterOn   = false;
+        bool  analogMode  = false;
+        bool  digitalPoly = false;  // FruityMatch::Curve::polynomial for the DIGITAL knee
+        AnalogClipCoeffs analogClip;  // analog clipper SILK, per block
+        int   adaaOrder   = 0;      // ADAA: 0 = off, 1, 2 (ANALOG: 1st order for both)
+    };
+
+    void processClipStage (juce::dsp::AudioBlock<float>& block, const ClipStageConfig& cfg);
+    void processClipChannel (float* samples, int numSamples, FruityMatch::AdaaState* adaa, const ClipStageConfig& cfg);
+    void processAnalogClip (juce::dsp::AudioBlock<float>& block, const ClipStageConfig& cfg);
+    void processAnalogClipParallel (juce::dsp::AudioBlock<float>& block, const ClipStageConfig& cfg);
+
+    // Channel-parallel clip stage: channel 1 runs on channelWorker while the
+    // audio thread does channel 0 (stereo DIGITAL, or ANALOG with ADAA on, >= x32;
+    // ANALOG without ADAA does both channels per instruction anyway). The worker runs
+    // on copies; if it is not done kWorkerMaxWait x our own channel's time
+    // after us, the audio thread does channel 1 itself.
+    static constexpr int    kParallelMinFactor = 32;
+    static constexpr double kWorkerMaxWait     = 0.5;
+
+    ChannelWorker channelWorker;
+
+    struct ChannelJob
+    {
+        FruityClipAudioProcessor* processor = nullptr;
+        std::vector<float> samples;             // channel 1, private copy (sized in prepareToPlay)
+        int    numSamples = 0;
+        ClipStageConfig cfg;                    // copy: an abandoned job may outlive the caller's
+        std::vector<FruityMatch::AdaaState> adaa;   // [0]: channel 1 ADAA state, private copy
+        bool   hasAdaa = false;
+
+        // ANALOG: channel 1 lane state (in lane 0), private copy; model and rates by value
+        const AnalogEngine::Variant* analogModel = nullptr;
+        AnalogEngine::Rates analogRates;
+        AnalogEngine::State analogState;
+    };
+
+    ChannelJob channelJob;
+
+    // Clip stage at the active factor (x1, OS, or DIGITAL prescan)
+    void processClipPath (juce::AudioBuffer<float>& buffer, const ClipStageConfig& cfg, bool subKneeIsIdentity);
+
+    // One chunk: input / output history bookkeeping around the clip path or a factor switch
+    void processClipChunk (juce::AudioBuffer<float>& buffer, const ClipStageConfig& cfg, bool subKneeIsIdentity);
+
+    // Stateful parts of the clip stage, saved around the old-factor render of a switch
+    struct ClipStateSnapshot
+    {
+        float limiterGain = 1.0f;
+        AnalogClipLaneState                  analogClip;
+        std::vector<FruityMatch::AdaaState>  adaa;
+    };
+
+    ClipStateSnapshot clipSnapshot;
+
+    void saveClipState();
+    void restoreClipState();
+    void processOversampleSwitch (juce::AudioBuffer<float>& buffer, const ClipStageConfig& cfg, bool subKneeIsIdentity,
+                                  bool haveHistory);
+
+    // up -> clip -> down, in place
+    void processOversampledClip (juce::dsp::AudioBlock<float>& block, const ClipStageConfig& cfg);
+
+    //==========================================================
+    // DIGITAL peak prescan (sparse oversampling)
+    //   Stretches that stay under the knee skip the oversampler and
+    //   the clip entirely; they are passed through delayed by the
+    //   oversampler latency. Decided per kPrescanSegment at base
+    //   rate, so only the over-knee regions of a block (plus guard
+    //   and hold) are oversampled. On the way back the oversampler
+    //   is reset and re-run over the preceding input so its filters
+    //   resume from consistent state, then crossfaded in.
+    //==========================================================
+    static constexpr int   kPrescanHistory     = 512;      // base-rate samples of input history (warm-up + delay)
+    static constexpr int   kPrescanSegment     = 128;      // decision granularity (also the look-ahead guard)
+    static constexpr int   kPrescanFade        = 64;       // crossfade between bypass and OS path
+    static constexpr float kPrescanHeadroom    = 0.7079f;  // -3 dB: upsampled peaks can exceed sample peaks
+    static constexpr float kPrescanHoldSeconds = 0.050f;   // quiet time before the OS path is dropped
+
+    juce::AudioBuffer<float> prescanDry;      // clip-stage input, [history | current chunk] per channel (every mode)
+    ClipLatency::Aligner clipAligner;         // clip-stage output history: switch alignment + latency pad
+    juce::AudioBuffer<float> prescanScratch;  // warm-up scratch
+    int  prescanQuietSamples = 0;
+    int  prescanLatency      = 0;             // integer OS latency in base-rate samples
+    int  clipLatencyTarget   = 0;             // clip path padded to this (>= prescanLatency); what is reported
+    bool prescanBypassed     = false;
+
+    static constexpr float kOsDutyWindowSeconds = 0.25f;
+
+    int osDutyOversampled = 0;                // samples run through the OS path this window
+    int osDutyTotal       = 0;                // clip-stage samples this window
+
+    void resetDigitalPrescan (int numChannels);
+    int  processDigitalPrescanned (juce::AudioBuffer<float>& buffer, const ClipStageConfig& cfg); // returns OS-path samples
+    void warmUpOversampler (int numChannels, int historyStart, const ClipStageConfig* clipCfg = nullptr);
+    void updateOversampleDuty (int oversampledSamples, int numSamples);
+
+    //==========================================================
+    // True-peak ceiling (BS.1770 4x estimator, look-ahead gain)
+    //   Runs at base rate after the final sample-peak clamp.
+    //   Adds TruePeakLimiter::getLatencyInSamples() while on.
+    //==========================================================
+    static constexpr std::array<float, 5> kTpCeilingDb { 0.0f, 0.0f, -0.3f, -1.0f, -2.0f }; // [0] = off
+
+    TruePeakLimiter truePeakLimiter;
+    int currentTpCeiling = 0;   // "tpCeiling" index, 0 = off
+
+    void updateReportedLatency();
+    int  getClipLatencyTarget (int filter, int osIndex, int automaticCeiling) const;
+
+    //==========================================================
+    // Bypass delay
+    //   Ring of the raw input, written every block. BYPASS reads
+    //   it back at the reported latency so the A/B stays aligned
+    //   with the host's delay compensation.
+    //==========================================================
+    static constexpr int kBypassDelayMax = kPrescanHistory + TruePeakLimiter::getLatencyInSamples();
+
+    juce::AudioBuffer<float> bypassDelay;
+    int bypassDelayWrite = 0;
+
+    void processBypassDelay (juce::AudioBuffer<float>& buffer, bool bypassed);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FruityClipAudioProcessor)
 };
@@ -0,0 +1,59 @@
+#pragma once
+// Stereo-SIMD halfband oversampler: Halfband::Cascade (HalfbandCascade.h)
+// behind the OversamplingEngine interface.
+//
+// At max quality every stage is juce::dsp::Oversampling's polyphase IIR
+// (filterHalfBandPolyphaseIIR, useIntegerLatency = true): the allpass
+// coefficients come from a port of the same FilterDesign call, the
+// operation order matches JUCE's scalar loop and the latency is computed the
+// same way, so the output agrees with JUCE stages built from the same
+// getHalfbandStageSpec to float rounding; Tests/HalfbandNullTest nulls it
+// against JUCE per factor, latency included, and Tests/HalfbandBench times
+// both. Balanced and eco run FIR stages after the first, which JUCE has no
+// exact counterpart for (PluginProcessor's fallback uses JUCE's equiripple
+// FIR there).
+
+#include "OversamplingEngine.h"
+
+class StereoHalfbandOversampler : public OversamplingEngine
+{
+public:
+    StereoHalfbandOversampler (int numChannelsToUse, int numStages,
+                               OversamplingQuality quality = OversamplingQuality::max)
+        : cascade (numChannelsToUse, numStages, quality) {}
+
+    void initProcessing (size_t maxSamplesPerBlock) override
+    {
+        cascade.prepare ((int) maxSamplesPerBlock);
+    }
+
+    void reset() noexcept override { cascade.reset(); }
+
+    juce::dsp::AudioBlock<float> processSamplesUp (const juce::dsp::AudioBlock<const float>& input) noexcept override
+    {
+        const int n = (int) input.getNumSamples();
+
+        cascade.processUp (input.getChannelPointer (0),
+                           input.getNumChannels() > 1 ? input.getChannelPointer (1) : nullptr, n);
+
+        for (int ch = 0; ch < cascade.getNumChannels(); ++ch)
+            upsampled[ch] = cascade.getUpsampled (ch);
+
+        return juce::dsp::AudioBlock<float> (upsampled, (size_t) cascade.getNumChannels(),
+                                             (size_t) (n * cascade.getFactor()));
+    }
+
+    void processSamplesDown (juce::dsp::AudioBlock<float>& output) noexcept override
+    {
+        cascade.processDown (output.getChannelPointer (0),
+                             output.getNumChannels() > 1 ? output.getChannelPointer (1) : nullptr,
+                             (int) output.getNumSamples());
+    }
+
+    float  getLatencyInSamples() const noexcept override   { return cascade.getLatency(); }
+    size_t getOversamplingFactor() const noexcept override { return (size_t) cascade.getFactor(); }
+
+private:
+    Halfband::Cascade cascade;
+    float* upsampled[2] = { nullptr, nullptr };
+};
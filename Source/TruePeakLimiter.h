@@ -0,0 +1,175 @@
+#pragma once
+// Look-ahead true-peak ceiling.
+//
+// Inter-sample peaks are estimated with the ITU-R BS.1770-4 (Annex 2) 4x
+// polyphase FIR, 4 phases x 12 taps, at base rate, so no oversampled copy of
+// the signal is ever built. Each sample's gain requirement is
+//
+//   r[m] = min (1, ceiling / max (|x[m]|, 4x points on either side of m))
+//
+// and the applied gain is a box average over W + 1 samples of the sliding
+// minimum of r over the next W + 1 samples. Every box window then contains
+// only values <= r[m], so g[m] <= r[m] by construction, with a W-sample
+// linear-ish attack and no overshoot. Release is a one-pole back to 1.
+// Channels are linked (same gain) so the stereo image does not move.
+//
+// Where the signal stays under the ceiling the gain is exactly 1 and the
+// output is the input delayed by getLatencyInSamples().
+//
+// The estimator reads true peak slightly low at the top of the band (the
+// BS.1770 meter has the same bias), so a ceiling of -1 dBTP is the
+// usual streaming-delivery target.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+class TruePeakLimiter
+{
+public:
+    static constexpr int kTaps      = 12;  // per phase
+    static constexpr int kPhases    = 4;
+    static constexpr int kLookahead = 32;  // W, base-rate samples of attack
+    static constexpr int kEstimatorDelay = kTaps / 2;  // 4x points around x[n - 6] are known at n
+
+    void prepare (int numChannels, double sampleRate)
+    {
+        channels = std::max (1, numChannels);
+
+        history.assign ((size_t) channels * kHistorySize, 0.0f);
+        delay.assign ((size_t) channels * kDelaySize, 0.0f);
+
+        releaseCoeff = (float) std::exp (-1.0 / (kReleaseSeconds * std::max (1.0, sampleRate)));
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        std::fill (history.begin(), history.end(), 0.0f);
+        std::fill (delay.begin(), delay.end(), 0.0f);
+        required.fill (1.0f);
+        held.fill (1.0f);
+
+        historyPos   = 0;
+        delayPos     = 0;
+        windowPos    = 0;
+        lastInterval = 0.0f;
+        heldSum      = (double) (kLookahead + 1);
+        gain         = 1.0f;
+    }
+
+    void setCeilingDb (float dBTP) noexcept        { ceiling = std::pow (10.0f, dBTP / 20.0f); }
+
+    static constexpr int getLatencyInSamples() noexcept { return kLookahead + kEstimatorDelay; }
+
+    // Current gain reduction (1 = none), for metering
+    float getGain() const noexcept                 { return gain; }
+
+    // In place; numChannels must not exceed the prepared count
+    void process (float* const* data, int numChannels, int numSamples) noexcept
+    {
+        numChannels = std::min (numChannels, channels);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // 1) True peak of the interval (n - 6, n - 5) and of sample n - 6
+            float interval = 0.0f;
+            float centre   = 0.0f;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float* h = history.data() + (size_t) ch * kHistorySize;
+
+                // mirrored ring: h[historyPos .. historyPos + kTaps) is always contiguous,
+                // newest sample first
+                h[historyPos] = h[historyPos + kTaps] = data[ch][i];
+                const float* x = h + historyPos;
+
+                for (int p = 0; p < kPhases; ++p)
+                {
+                    const float* c = kCoefficients[(size_t) p].data();
+                    float y = 0.0f;
+
+                    for (int k = 0; k < kTaps; ++k)
+                        y += c[k] * x[k];
+
+                    interval = std::max (interval, std::abs (y));
+                }
+
+                centre = std::max (centre, std::abs (x[kEstimatorDelay]));
+            }
+
+            historyPos = (historyPos == 0) ? kTaps - 1 : historyPos - 1;
+
+            // 2) Requirement of sample n - 6: it bounds the intervals on both sides
+            const float peak = std::max (centre, std::max (interval, lastInterval));
+            lastInterval = interval;
+
+            const float r = (peak > ceiling) ? ceiling / peak : 1.0f;
+
+            // 3) Sliding minimum over the last W + 1 requirements, box-averaged
+            required[(size_t) windowPos] = r;
+            float minimum = 1.0f;
+            for (float v : required)
+                minimum = std::min (minimum, v);
+
+            heldSum += (double) minimum - (double) held[(size_t) windowPos];
+            held[(size_t) windowPos] = minimum;
+            windowPos = (windowPos + 1 == kWindow) ? 0 : windowPos + 1;
+
+            const float target = std::min (1.0f, (float) (heldSum / (double) kWindow));
+
+            // 4) Instant attack (already smoothed by the box), one-pole release
+            gain = (target < gain) ? target : target + releaseCoeff * (gain - target);
+
+            // 5) Apply to the sample the gain was computed for
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float* d = delay.data() + (size_t) ch * kDelaySize;
+                const float in = data[ch][i];
+
+                data[ch][i] = d[delayPos] * gain;
+                d[delayPos] = in;
+            }
+
+            delayPos = (delayPos + 1 == kDelaySize) ? 0 : delayPos + 1;
+        }
+    }
+
+private:
+    static constexpr int   kWindow          = kLookahead + 1;
+    static constexpr int   kHistorySize     = 2 * kTaps;
+    static constexpr int   kDelaySize       = kLookahead + kEstimatorDelay;
+    static constexpr float kReleaseSeconds  = 0.050f;
+
+    // ITU-R BS.1770-4, Annex 2, Table 1 (phase-major)
+    static constexpr std::array<std::array<float, kTaps>, kPhases> kCoefficients {{
+        {  0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f, -0.0594482421875f,  0.1373291015625f,
+           0.9721679687500f, -0.1022949218750f,  0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f },
+        { -0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f, -0.1665039062500f,  0.4650878906250f,
+           0.7797851562500f, -0.2003173828125f,  0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f },
+        { -0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f, -0.2003173828125f,  0.7797851562500f,
+           0.4650878906250f, -0.1665039062500f,  0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f },
+        { -0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f, -0.1022949218750f,  0.9721679687500f,
+           0.1373291015625f, -0.0594482421875f,  0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f }
+    }};
+
+    int channels = 0;
+
+    std::vector<float> history;   // channels x kHistorySize (mirrored ring)
+    std::vector<float> delay;     // channels x kDelaySize
+    std::array<float, kWindow> required {};
+    std::array<float, kWindow> held {};
+
+    int    historyPos   = 0;
+    int    delayPos     = 0;
+    int    windowPos    = 0;
+    float  lastInterval = 0.0f;
+    double heldSum      = (double) kWindow;
+
+    float ceiling      = 1.0f;
+    float gain         = 1.0f;
+    float releaseCoeff = 0.0f;
+};
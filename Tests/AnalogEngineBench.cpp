@@ -0,0 +1,98 @@
+// ANALOG clipper timings per variant (kVariants), at the control ticks the
+// oversampling factors give, ADAA off and on. Not a ctest test; run it by
+// hand on the machine you care about.
+//
+// Input is lowpassed stereo noise peaking ~6 dB into the ceiling, so every
+// part of the model is busy; a quiet pass (-24 dB) shows the linear ticks.
+
+#include "../Source/AnalogEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace AnalogEngine;
+
+int main()
+{
+    constexpr int    kSamples    = 1 << 16;
+    constexpr int    kRuns       = 20;
+    constexpr double kSampleRate = 48000.0;
+
+    std::vector<float> sourceL ((size_t) kSamples), sourceR ((size_t) kSamples);
+
+    uint32_t seed = 0x9e3779b9u;
+    float lowL = 0.0f, lowR = 0.0f;
+
+    auto noise = [&seed]
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return (float) (seed >> 8) * (2.0f / 16777216.0f) - 1.0f;
+    };
+
+    for (int i = 0; i < kSamples; ++i)
+    {
+        lowL = 0.97f * lowL + 0.03f * noise();
+        lowR = 0.97f * lowR + 0.03f * noise();
+        sourceL[(size_t) i] = 8.0f * lowL;
+        sourceR[(size_t) i] = 8.0f * lowR;
+    }
+
+    std::vector<float> left, right;
+    float sink = 0.0f;
+
+    for (float level : { 1.0f, 0.063f })
+    {
+        std::printf ("\ninput x %.3f\n", level);
+
+        for (int factor : { 1, 8, 64 })
+        {
+            for (bool antiAlias : { false, true })
+            {
+                for (int model = 0; model < (int) Model::numModels; ++model)
+                {
+                    const auto& v = kVariants[model];
+                    const auto rates = v.makeRates (kSampleRate, factor);
+                    const int blockSize = 64 * factor;
+
+                    ClipCoeffs c;
+                    c.srEff = (float) kSampleRate * (float) factor;
+
+                    double best = 1.0e30;
+
+                    for (int run = 0; run < kRuns; ++run)
+                    {
+                        left.assign (sourceL.begin(), sourceL.end());
+                        right.assign (sourceR.begin(), sourceR.end());
+
+                        for (size_t i = 0; i < left.size(); ++i)
+                        {
+                            left[i]  *= level;
+                            right[i] *= level;
+                        }
+
+                        State st;
+
+                        const auto t0 = std::chrono::steady_clock::now();
+                        for (int start = 0; start < kSamples; start += blockSize)
+                        {
+                            float* channels[2] = { left.data() + start, right.data() + start };
+                            v.process (st, rates, c, channels, 2, std::min (blockSize, kSamples - start), antiAlias);
+                        }
+                        const auto t1 = std::chrono::steady_clock::now();
+
+                        best = std::min (best, std::chrono::duration<double, std::nano> (t1 - t0).count() / kSamples);
+                        sink += left[(size_t) run];
+                    }
+
+                    std::printf ("  %-12s x%-3d ADAA %-3s %8.2f ns/sample (stereo)\n",
+                                 v.name, factor, antiAlias ? "on" : "off", best);
+                }
+            }
+        }
+    }
+
+    return sink == 12345.0f ? 1 : 0;
+}
@@ -0,0 +1,178 @@
+// AnalogEngine: the linear-tick fast path (process) against the full model
+// on every tick (processReference), per variant, control tick (factor),
+// ADAA on / off and block sizes that split ticks.
+//
+// Linear ticks only drop the knee and hold the recon blend constant instead
+// of interpolating it between two equal values, so both must agree to float
+// rounding, with the envelopes crossing in and out of the linear region.
+//
+// Also: a stereo pass against the per-channel split the channel worker does
+// (laneOf / setLane, one channel per process call), which only moves the
+// per-tick shortcut decisions from both channels to each.
+
+#include "TestUtil.h"
+#include "../Source/AnalogEngine.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace AnalogEngine;
+
+// Lowpassed stereo noise at a quiet level, with a +18 dB burst every 8th
+// stretch so the level envelope and the knee engage and release again
+static void makeSignal (std::vector<float>& left, std::vector<float>& right, int stretch)
+{
+    uint32_t seed = 0x2545f491u;
+    float lowL = 0.0f, lowR = 0.0f;
+
+    auto noise = [&seed]
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return (float) (seed >> 8) * (2.0f / 16777216.0f) - 1.0f;
+    };
+
+    for (size_t i = 0; i < left.size(); ++i)
+    {
+        lowL = 0.97f * lowL + 0.03f * noise();
+        lowR = 0.97f * lowR + 0.03f * noise();
+
+        const float gain = ((int) i / stretch) % 8 == 7 ? 8.0f : 1.0f;
+        left[i]  = gain * 1.5f * lowL;
+        right[i] = gain * 1.5f * lowR;
+    }
+}
+
+template <typename E>
+static double worstDifference (int factor, bool antiAlias, int blockSize)
+{
+    // 4096 base-rate samples, two bursts
+    const int numSamples = 4096 * factor;
+
+    std::vector<float> left ((size_t) numSamples), right ((size_t) numSamples);
+    makeSignal (left, right, 256 * factor);
+
+    auto refLeft = left, refRight = right;
+
+    const auto rates = E::makeRates (48000.0, factor);
+
+    ClipCoeffs c;
+    c.silkShape = 0.3f;
+    c.sRecon    = 0.15f;
+    c.baseDrive = 1.2f;
+    c.srEff     = 48000.0f * (float) factor;
+
+    State fast, ref;
+
+    for (int start = 0; start < numSamples; start += blockSize)
+    {
+        const int n = std::min (blockSize, numSamples - start);
+
+        float* a[2] = { left.data() + start, right.data() + start };
+        float* b[2] = { refLeft.data() + start, refRight.data() + start };
+
+        E::process          (fast, rates, c, a, 2, n, antiAlias);
+        E::processReference (ref,  rates, c, b, 2, n, antiAlias);
+    }
+
+    double worst = 0.0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        worst = std::max (worst, (double) std::abs (left[(size_t) i]  - refLeft[(size_t) i]));
+        worst = std::max (worst, (double) std::abs (right[(size_t) i] - refRight[(size_t) i]));
+    }
+
+    return worst;
+}
+
+template <typename E>
+static double worstSplitDifference (int factor, int blockSize)
+{
+    const int numSamples = 4096 * factor;
+
+    std::vector<float> left ((size_t) numSamples), right ((size_t) numSamples);
+    makeSignal (left, right, 256 * factor);
+
+    auto splitLeft = left, splitRight = right;
+
+    const auto rates = E::makeRates (48000.0, factor);
+
+    ClipCoeffs c;
+    c.silkShape = 0.3f;
+    c.sRecon    = 0.15f;
+    c.baseDrive = 1.2f;
+    c.srEff     = 48000.0f * (float) factor;
+
+    State stereo, split;
+
+    for (int start = 0; start < numSamples; start += blockSize)
+    {
+        const int n = std::min (blockSize, numSamples - start);
+
+        float* a[2] = { left.data() + start, right.data() + start };
+        E::process (stereo, rates, c, a, 2, n, true);
+
+        auto lane1 = laneOf (split, 1);
+
+        float* channel0[1] = { splitLeft.data() + start };
+        float* channel1[1] = { splitRight.data() + start };
+        E::process (split, rates, c, channel0, 1, n, true);
+        E::process (lane1, rates, c, channel1, 1, n, true);
+
+        setLane (split, 1, lane1);
+    }
+
+    double worst = 0.0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        worst = std::max (worst, (double) std::abs (left[(size_t) i]  - splitLeft[(size_t) i]));
+        worst = std::max (worst, (double) std::abs (right[(size_t) i] - splitRight[(size_t) i]));
+    }
+
+    return worst;
+}
+
+template <typename E>
+static void checkVariant (TestUtil::Checks& checks, const char* name)
+{
+    constexpr double kBound = 1.0e-6;
+
+    for (int factor : { 1, 4, 32, 64 })
+    {
+        for (bool antiAlias : { false, true })
+        {
+            // 100 * factor + 3: blocks end mid-tick
+            for (int blockSize : { 512 * factor, 100 * factor + 3 })
+            {
+                char what[96];
+                std::snprintf (what, sizeof (what), "%s x%d, ADAA %s, block %d (abs)",
+                               name, factor, antiAlias ? "on" : "off", blockSize);
+
+                const double d = worstDifference<E> (factor, antiAlias, blockSize);
+                checks.expect (d <= kBound, what, d, kBound);
+            }
+        }
+    }
+
+    // The worker split only runs at >= x32 with ADAA on
+    for (int factor : { 32, 64 })
+    {
+        char what[96];
+        std::snprintf (what, sizeof (what), "%s x%d, per-channel split vs stereo (abs)", name, factor);
+
+        const double d = worstSplitDifference<E> (factor, 100 * factor + 3);
+        checks.expect (d <= kBound, what, d, kBound);
+    }
+}
+
+int main()
+{
+    TestUtil::Checks checks;
+
+    checkVariant<KneeEngine>      (checks, "KNEE");
+    checkVariant<KneeTableEngine> (checks, "KNEE TABLE");
+    checkVariant<HardEngine>      (checks, "HARD");
+
+    return checks.exitCode();
+}
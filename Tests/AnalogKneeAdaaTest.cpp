@@ -0,0 +1,197 @@
+// The ANALOG knee's first-order ADAA (AnalogKneeADAA.h), on and off, at x1
+// and x2 (44.1 kHz base rate), on a 5 kHz sine 1.9 dB and 6 dB over the
+// ceiling. Aliases are read with ideal decimation: the worst component in
+// 0..20 kHz that is not a harmonic of the sine, in dBc.
+//
+//   knee    – DynamicKnee alone at its resting width (0.38): ADAA must take
+//             off what the ADAA commit claimed (within 1 dB).
+//   engine  – the same sine through AnalogEngine::KneeEngine::process. Here
+//             the front's slope gate (a smoothstep on |dx|, ahead of the
+//             knee) aliases as much as the knee does, and ADAA cannot touch
+//             it, so end to end it gains 2-4 dB; at x2 / +6 dB it even reads
+//             2 dB worse, because the knee's aliases had partly cancelled the
+//             gate's there. Held to the measured levels (1 dB headroom).
+//   linear  – below the knee, ADAA is the two-tap mean of the knee input,
+//             and everything after the knee is linear, so the output must be
+//             the ADAA-off output averaged over two taps. Exact on linear
+//             ticks; once the level envelope engages the recon blend moves
+//             per sample, which the mean does not commute with (bounded).
+//
+// The sine is coherent with the analysis window (an integer number of
+// cycles), so every harmonic and every folded image lands on its own bin and
+// no window is needed.
+
+#include "TestUtil.h"
+#include "../Source/AnalogEngine.h"
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+using namespace AnalogEngine;
+
+namespace {
+constexpr double kRate     = 44100.0;
+constexpr int    kWindow   = 8192;   // base-rate samples analysed
+constexpr int    kCycles   = 935;    // 5033 Hz; shares no factor with kWindow
+constexpr int    kSettle   = 8;      // windows run before the analysed one
+constexpr double kPi       = 3.14159265358979323846;
+
+// The engine at factor x on amplitude * sine; returns the last window
+std::vector<float> render (int factor, double amplitude, bool antiAlias)
+{
+    const int window = kWindow * factor;
+    const int total  = window * (kSettle + 1);
+    const int block  = 512 * factor;
+
+    std::vector<float> x ((size_t) total);
+    for (int i = 0; i < total; ++i)
+        x[(size_t) i] = (float) (amplitude * std::sin (2.0 * kPi * kCycles * i / window));
+
+    const auto rates = KneeEngine::makeRates (kRate, factor);
+
+    ClipCoeffs c;
+    c.srEff = (float) kRate * (float) factor;
+
+    State st;
+
+    for (int start = 0; start < total; start += block)
+    {
+        float* ch[1] = { x.data() + start };
+        KneeEngine::process (st, rates, c, ch, 1, std::min (block, total - start), antiAlias);
+    }
+
+    return std::vector<float> (x.end() - window, x.end());
+}
+
+// DynamicKnee alone at width 0.38, plain or ADAA; returns the last window
+std::vector<float> renderKnee (int factor, double amplitude, bool antiAlias)
+{
+    const int window = kWindow * factor;
+    std::vector<float> y ((size_t) window);
+    double x1 = 0.0;
+
+    for (int i = -window; i < window; ++i)
+    {
+        const float x = (float) (amplitude * std::sin (2.0 * kPi * kCycles * i / window));
+        float out;
+
+        if (antiAlias)
+        {
+            out = DynamicKnee::adaaSample (x, 0.38f, x1);
+        }
+        else
+        {
+            ChannelLanes::Array lanes;
+            ChannelLanes::store (DynamicKnee::shape (ChannelLanes::broadcast (x), ChannelLanes::broadcast (0.38f)), lanes);
+            out = lanes[0];
+        }
+
+        if (i >= 0)
+            y[(size_t) i] = out;
+    }
+
+    return y;
+}
+
+// Worst non-harmonic bin in 0..20 kHz against the fundamental (dBc)
+double worstAliasDbc (const std::vector<float>& y)
+{
+    const int n       = (int) y.size();
+    const int topBin  = (int) (20000.0 / (kRate / kWindow));
+
+    auto bin = [&y, n] (int k)
+    {
+        const std::complex<double> step = std::polar (1.0, -2.0 * kPi * k / n);
+        std::complex<double> rotor (1.0, 0.0), sum (0.0, 0.0);
+
+        for (int i = 0; i < n; ++i)
+        {
+            sum   += (double) y[(size_t) i] * rotor;
+            rotor *= step;
+        }
+
+        return std::abs (sum);
+    };
+
+    const double fundamental = bin (kCycles);
+    double worst = 0.0;
+
+    for (int k = 1; k <= topBin; ++k)
+        if (k % kCycles != 0)
+            worst = std::max (worst, bin (k));
+
+    return 20.0 * std::log10 (std::max (worst, 1.0e-30) / fundamental);
+}
+} // namespace
+
+int main()
+{
+    TestUtil::Checks checks;
+
+    const struct
+    {
+        int    factor;
+        double overDb;
+        double kneeReductionDb;   // claimed, knee alone
+        double engineReductionDb; // measured end to end (plain - ADAA), minus 1 dB
+        double engineAdaaDbc;     // measured end to end with ADAA, plus 1 dB
+    } cases[] =
+    {
+        { 1, 1.9, 12.7,  2.6, -44.7 },
+        { 1, 6.0,  4.5,  2.5, -42.5 },
+        { 2, 1.9, 13.7,  1.4, -58.3 },
+        { 2, 6.0, 14.3, -3.3, -65.2 },
+    };
+
+    for (const auto& tc : cases)
+    {
+        const double amplitude = std::pow (10.0, tc.overDb / 20.0);
+        char what[128];
+
+        {
+            const double plain = worstAliasDbc (renderKnee (tc.factor, amplitude, false));
+            const double adaa  = worstAliasDbc (renderKnee (tc.factor, amplitude, true));
+            const double bound = tc.kneeReductionDb - 1.0;
+
+            std::snprintf (what, sizeof (what), "knee x%d +%.1f dB: plain %.1f, ADAA %.1f dBc; reduction (dB)",
+                           tc.factor, tc.overDb, plain, adaa);
+            checks.expect (plain - adaa >= bound, what, plain - adaa, bound);
+        }
+
+        {
+            const double plain = worstAliasDbc (render (tc.factor, amplitude, false));
+            const double adaa  = worstAliasDbc (render (tc.factor, amplitude, true));
+
+            std::snprintf (what, sizeof (what), "engine x%d +%.1f dB: plain %.1f, ADAA %.1f dBc; reduction (dB)",
+                           tc.factor, tc.overDb, plain, adaa);
+            checks.expect (plain - adaa >= tc.engineReductionDb, what, plain - adaa, tc.engineReductionDb);
+
+            std::snprintf (what, sizeof (what), "engine x%d +%.1f dB: ADAA aliases (dBc)", tc.factor, tc.overDb);
+            checks.expect (adaa <= tc.engineAdaaDbc, what, adaa, tc.engineAdaaDbc);
+        }
+    }
+
+    // Below the knee: ADAA output = two-tap mean of the plain output. 0.5
+    // peak stays on linear ticks; 0.9 runs the full path with the recon blend
+    // engaged and moving
+    for (int factor : { 1, 2 })
+    {
+        for (double amplitude : { 0.5, 0.9 })
+        {
+            const double bound = amplitude < 0.55 ? 1.0e-6 : 1.0e-3;
+            const auto plain = render (factor, amplitude, false);
+            const auto adaa  = render (factor, amplitude, true);
+
+            double worst = 0.0;
+            for (size_t i = 1; i < plain.size(); ++i)
+                worst = std::max (worst, (double) std::abs (adaa[i] - 0.5f * (plain[i] + plain[i - 1])));
+
+            char what[96];
+            std::snprintf (what, sizeof (what), "x%d %.1f peak: ADAA vs two-tap mean of plain (abs)", factor, amplitude);
+            checks.expect (worst <= bound, what, worst, bound);
+        }
+    }
+
+    return checks.exitCode();
+}
@@ -0,0 +1,144 @@
+// AutoOversample::Controller driven by simulated processBlock timings, with
+// the processor's wiring around it: the live factor is min (user, ceiling)
+// and every change holds the controller (PluginProcessor::processBlock).
+//
+// The simulated cost is a fixed part plus an oversampled part that doubles
+// per factor step, with deterministic jitter. The controller must settle on
+// the highest factor under kBudget, stay there, and never step faster than
+// kHoldSeconds.
+
+#include "TestUtil.h"
+#include "../Source/AutoOversample.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+using namespace AutoOversample;
+
+static constexpr double kSampleRate = 48000.0;
+static constexpr int    kBlock      = 512;
+static constexpr int    kMaxIndex   = 6;   // x64
+
+// Load (time / deadline) at a factor index, at time t seconds
+using CostModel = std::function<double (int index, double t)>;
+
+struct Run
+{
+    std::vector<int>    index;     // live factor index per block
+    std::vector<double> changes;   // times of factor changes, seconds
+};
+
+static Run simulate (const CostModel& cost, double seconds, int userIndex, double jitter)
+{
+    Controller ctl;
+    ctl.reset (kMaxIndex);
+
+    Run run;
+    int current = userIndex;
+    uint32_t seed = 12345u;
+
+    const double deadline = (double) kBlock / kSampleRate;
+    const int numBlocks   = (int) (seconds / deadline);
+
+    for (int b = 0; b < numBlocks; ++b)
+    {
+        const double t = b * deadline;
+
+        const int live = ctl.ceiling < userIndex ? ctl.ceiling : userIndex;
+        if (live != current)
+        {
+            current = live;
+            ctl.hold (kSampleRate);
+            run.changes.push_back (t);
+        }
+
+        seed = seed * 1664525u + 1013904223u;
+        const double noise = (double) (seed >> 8) / 16777216.0 * 2.0 - 1.0;
+
+        ctl.update (cost (current, t) * (1.0 + jitter * noise) * deadline, kBlock, kSampleRate, userIndex);
+        run.index.push_back (current);
+    }
+
+    return run;
+}
+
+// 0.02 + 0.01 * 2^index: x16 = 0.18 fits the 0.30 budget, x32 = 0.34 does not
+static double steadyCost (int index, double) { return 0.02 + 0.01 * (double) (1 << index); }
+
+static int indexAt (const Run& run, double t)
+{
+    return run.index[(size_t) (t * kSampleRate / kBlock)];
+}
+
+// Number of changes after t
+static int changesAfter (const Run& run, double t)
+{
+    int n = 0;
+    for (double c : run.changes)
+        n += c > t ? 1 : 0;
+    return n;
+}
+
+static double shortestGap (const Run& run)
+{
+    double gap = 1.0e9;
+    for (size_t i = 1; i < run.changes.size(); ++i)
+        gap = std::min (gap, run.changes[i] - run.changes[i - 1]);
+    return gap;
+}
+
+int main()
+{
+    TestUtil::Checks checks;
+
+    // Steady load, from x64: down to x16 within a few seconds, then no movement
+    {
+        const Run run = simulate (steadyCost, 60.0, kMaxIndex, 0.0);
+        checks.expect (indexAt (run, 5.0) == 4,   "steady: index at 5 s (x16 = 4)", indexAt (run, 5.0), 4);
+        checks.expect (changesAfter (run, 5.0) == 0, "steady: changes after 5 s", changesAfter (run, 5.0), 0);
+        checks.expect (run.changes.size() == 2,   "steady: changes in total (64 -> 32 -> 16)", (double) run.changes.size(), 2);
+    }
+
+    // +-25 % block-to-block jitter: same factor, no oscillation
+    {
+        const Run run = simulate (steadyCost, 60.0, kMaxIndex, 0.25);
+        checks.expect (indexAt (run, 59.0) == 4,  "jitter: index at 59 s", indexAt (run, 59.0), 4);
+        checks.expect (changesAfter (run, 5.0) == 0, "jitter: changes after 5 s", changesAfter (run, 5.0), 0);
+    }
+
+    // 3x load for 0.5 s at 20 s (another plugin, a GC pause...): steps down,
+    // recovers to x16 and stays; never faster than the hold
+    {
+        auto spiky = [] (int index, double t) { return steadyCost (index, t) * ((t >= 20.0 && t < 20.5) ? 3.0 : 1.0); };
+        const Run run = simulate (spiky, 60.0, kMaxIndex, 0.1);
+
+        int lowest = kMaxIndex;
+        for (double t = 20.0; t < 30.0; t += 0.01)
+            lowest = std::min (lowest, indexAt (run, t));
+
+        checks.expect (lowest < 4,                 "spike: stepped down during the spike", lowest, 3);
+        checks.expect (indexAt (run, 40.0) == 4,   "spike: back to x16 at 40 s", indexAt (run, 40.0), 4);
+        checks.expect (changesAfter (run, 40.0) == 0, "spike: changes after 40 s", changesAfter (run, 40.0), 0);
+        checks.expect (shortestGap (run) >= kHoldSeconds, "spike: shortest gap between changes (s)", shortestGap (run), kHoldSeconds);
+    }
+
+    // User ceiling below what fits: stays at the user's factor
+    {
+        const Run run = simulate (steadyCost, 20.0, 3, 0.1);
+        checks.expect (run.changes.empty(),        "user x8: changes", (double) run.changes.size(), 0);
+        checks.expect (indexAt (run, 19.0) == 3,   "user x8: index at 19 s", indexAt (run, 19.0), 3);
+    }
+
+    // Load falls away (track muted elsewhere): climbs back to the user's factor
+    {
+        auto easing = [] (int index, double t) { return t < 10.0 ? steadyCost (index, t) : 0.3 * steadyCost (index, t); };
+        const Run run = simulate (easing, 40.0, kMaxIndex, 0.1);
+        checks.expect (indexAt (run, 9.0) == 4,    "easing: index at 9 s", indexAt (run, 9.0), 4);
+        checks.expect (indexAt (run, 39.0) == 6,   "easing: index at 39 s", indexAt (run, 39.0), 6);
+        checks.expect (changesAfter (run, 25.0) == 0, "easing: changes after 25 s", changesAfter (run, 25.0), 0);
+    }
+
+    return checks.exitCode();
+}
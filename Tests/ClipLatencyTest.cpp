@@ -0,0 +1,230 @@
+// ClipLatency::Aligner with the processor's wiring around it
+// (PluginProcessor::processClipChunk / processOversampleSwitch): on a factor
+// switch the old factor renders the chunk once more and is crossfaded into
+// the new one, delay-aligned; every chunk is then padded to the target.
+//
+// The clip paths are pure delays with the (non-monotonic) latencies of a
+// filter row, so old and new agree exactly and the padded output must be the
+// input delayed by exactly the reported latency – sample for sample, through
+// every switch – with the reported latency (ClipLatency::reported, as
+// processBlock computes it) never moving. Auto's steps come from
+// AutoOversample::Controller under a varying simulated load.
+
+#include "TestUtil.h"
+#include "../Source/AutoOversample.h"
+#include "../Source/ClipLatency.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+static constexpr int kNumFactors = 7;     // x1 .. x64
+static constexpr int kHistory    = 512;   // PluginProcessor::kPrescanHistory
+static constexpr int kMaxBlock   = 480;
+static constexpr int kFade       = 256;   // PluginProcessor::kOsSwitchFade
+static constexpr int kNumBlocks  = 2000;
+
+// Base-rate latency per factor index; IIR and FIR rows are not monotonic
+static const int kLatencies[kNumFactors] = { 0, 7, 12, 40, 33, 35, 38 };
+
+// Factor index for a block of numSamples, given the previous one (-1 at the start)
+using Picker = std::function<int (int block, int current, int numSamples)>;
+
+struct Run
+{
+    double worst           = 0.0;   // worst |output - input delayed by the reported latency|
+    int    switches        = 0;
+    int    reported        = 0;     // reported latency at the start
+    int    reportedChanges = 0;     // blocks where it differed from the previous block
+};
+
+// automaticCeiling as for ClipLatency::reported: -1 = the user's factor
+static Run render (const Picker& pick, int automaticCeiling)
+{
+    constexpr int numChannels = 2;
+
+    ClipLatency::Aligner aligner;
+    aligner.prepare (numChannels, kHistory, kMaxBlock);
+
+    std::vector<float> input[numChannels];
+    uint32_t seed = 0x2545f491u;
+
+    for (auto& x : input)
+    {
+        x.resize ((size_t) kNumBlocks * kMaxBlock);
+
+        for (auto& s : x)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            s = (float) (seed >> 8) * (1.0f / 16777216.0f) - 0.5f;
+        }
+    }
+
+    // Factor index's clip path over [start, start + n): the input delayed by its latency
+    auto clipPath = [&input] (int ch, int index, int start, int n, float* out)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const int src = start + i - kLatencies[index];
+            out[i] = src >= 0 ? input[ch][(size_t) src] : 0.0f;
+        }
+    };
+
+    std::vector<float> block[numChannels], previous[numChannels];
+    float* blockPtr[numChannels];
+    const float* previousPtr[numChannels];
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        block[ch].resize (kMaxBlock);
+        previous[ch].resize (kMaxBlock);
+        blockPtr[ch]    = block[ch].data();
+        previousPtr[ch] = previous[ch].data();
+    }
+
+    Run run;
+    int current = pick (0, -1, 0);
+    int target  = ClipLatency::reported (kLatencies, current, automaticCeiling);
+    int start   = 0;
+
+    run.reported = target;
+
+    for (int b = 0; b < kNumBlocks; ++b)
+    {
+        // Ragged chunks, as the host hands them over
+        const int n    = (b % 5 == 3) ? 97 : (b % 7 == 1 ? kMaxBlock : 256);
+        const int next = pick (b, current, n);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            clipPath (ch, next, start, n, blockPtr[ch]);
+
+        if (next != current)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                clipPath (ch, current, start, n, previous[ch].data());
+
+            aligner.crossfade (blockPtr, previousPtr, numChannels, n, kLatencies[next] - kLatencies[current], kFade);
+            current = next;
+            ++run.switches;
+        }
+
+        const int reported = ClipLatency::reported (kLatencies, current, automaticCeiling);
+        run.reportedChanges += (reported != target) ? 1 : 0;
+        target = reported;
+
+        aligner.pad (blockPtr, numChannels, n, target - kLatencies[current]);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                const int src = start + i - target;
+                const float expected = src >= 0 ? input[ch][(size_t) src] : 0.0f;
+                run.worst = std::max (run.worst, (double) std::abs (block[ch][(size_t) i] - expected));
+            }
+        }
+
+        start += n;
+    }
+
+    return run;
+}
+
+int main()
+{
+    TestUtil::Checks checks;
+
+    // Offline planner: any factor, per region, held for a few blocks. The
+    // target is the row's largest latency, fixed before the render starts.
+    {
+        uint32_t seed = 777u;
+        auto planner = [&seed] (int block, int current, int)
+        {
+            if (current >= 0 && block % 3 != 0)
+                return current;
+
+            seed = seed * 1664525u + 1013904223u;
+            return (int) ((seed >> 16) % (uint32_t) kNumFactors);
+        };
+
+        const Run run = render (planner, kNumFactors - 1);
+        checks.expect (run.reported == 40,       "planner: reported = largest latency of the row", run.reported, 40);
+        checks.expect (run.switches > 300,       "planner: factor switches", run.switches, 300);
+        checks.expect (run.reportedChanges == 0, "planner: reported latency changes", run.reportedChanges, 0);
+        checks.expect (run.worst == 0.0,         "planner: output vs input delayed by the reported", run.worst, 0.0);
+    }
+
+    // Every ordered pair of factors, back and forth
+    {
+        auto pairs = [] (int block, int, int)
+        {
+            const int pair = (block / 2) % (kNumFactors * kNumFactors);
+            return (block % 2 == 0) ? pair / kNumFactors : pair % kNumFactors;
+        };
+
+        const Run run = render (pairs, kNumFactors - 1);
+        checks.expect (run.reportedChanges == 0, "pairs: reported latency changes", run.reportedChanges, 0);
+        checks.expect (run.worst == 0.0,         "pairs: output vs input delayed by the reported", run.worst, 0.0);
+    }
+
+    // Auto under a load that comes and goes: the controller steps the live
+    // factor min (user, ceiling) down and back up (processBlock's wiring);
+    // the reported latency stays the user's factor's throughout
+    for (const int userIndex : { 6, 5, 2 })
+    {
+        constexpr double sampleRate = 48000.0;
+
+        AutoOversample::Controller ctl;
+        ctl.reset (kNumFactors - 1);
+
+        double t = 0.0;
+        int lowest = userIndex;
+
+        auto autoSteps = [&] (int, int current, int numSamples)
+        {
+            if (current < 0)
+                return userIndex;
+
+            // 0.02 + 0.01 * 2^index, eight times that for 1.5 s out of every 3 s
+            const double deadline = numSamples / sampleRate;
+            const double load     = (0.02 + 0.01 * (double) (1 << current)) * (std::fmod (t, 3.0) < 1.5 ? 8.0 : 1.0);
+            ctl.update (load * deadline, numSamples, sampleRate, userIndex);
+            t += deadline;
+
+            const int live = std::min (userIndex, ctl.ceiling);
+
+            if (live != current)
+                ctl.hold (sampleRate);
+
+            lowest = std::min (lowest, live);
+            return live;
+        };
+
+        const Run run = render (autoSteps, userIndex);
+        const int expected = ClipLatency::target (kLatencies, 0, userIndex);
+
+        char what[96];
+        std::snprintf (what, sizeof (what), "auto x%d: steps", 1 << userIndex);
+        checks.expect (run.switches >= 4 && lowest < userIndex, what, run.switches, 4);
+
+        std::snprintf (what, sizeof (what), "auto x%d: reported = user factor's (padded)", 1 << userIndex);
+        checks.expect (run.reported == expected, what, run.reported, expected);
+
+        std::snprintf (what, sizeof (what), "auto x%d: reported latency changes", 1 << userIndex);
+        checks.expect (run.reportedChanges == 0, what, run.reportedChanges, 0);
+
+        std::snprintf (what, sizeof (what), "auto x%d: output vs input delayed by the reported", 1 << userIndex);
+        checks.expect (run.worst == 0.0, what, run.worst, 0.0);
+    }
+
+    // No automatic switching: the active factor's own latency, no pad
+    {
+        const Run run = render ([] (int, int, int) { return 4; }, -1);
+        checks.expect (run.reported == 33, "fixed x16: reported = own latency", run.reported, 33);
+        checks.expect (run.worst == 0.0,   "fixed x16: output vs input delayed by its latency", run.worst, 0.0);
+    }
+
+    return checks.exitCode();
+}
@@ -0,0 +1,113 @@
+// DsmCaptureFit against the 32-band capture curve, as DsmCaptureEq::prepare
+// runs it (4 .. 6 sections, 0.25 dB), at 44.1 / 48 / 88.2 / 96 / 192 kHz:
+//
+//   fit      – within tolerance with at most 6 sections, so the processor
+//              runs the fit and not the reference cascade
+//   measured – the worst dB error, evaluated here on our own denser grid
+//              from the float coefficients the processor builds, agrees with
+//              the maxErrorDb the fitter reports and stays within tolerance
+//
+// and the fallback: a jagged reference (alternating +-6 dB, Q = 4) that no
+// 6-section fit follows must come back above tolerance, which is what makes
+// DsmCaptureEq keep the band cascade.
+
+#include "TestUtil.h"
+#include "../Source/DsmCaptureFit.h"
+
+#include <algorithm>
+#include <complex>
+
+namespace {
+constexpr int    kMinSections = 4;      // DsmCaptureEq::kMinFitSections
+constexpr int    kMaxSections = 6;      // DsmCaptureEq::kMaxFitSections
+constexpr double kToleranceDb = 0.25;   // DsmCaptureEq::kFitToleranceDb
+constexpr int    kPoints      = 4000;
+constexpr double kPi          = 3.14159265358979323846;
+
+// |H| in dB of a biquad at hz; toFloat rounds the coefficients as the
+// processor builds them (the reference is the exact curve)
+double biquadDb (const DsmCaptureFit::Biquad& c, double gain, double hz, double sampleRate, bool toFloat)
+{
+    const std::complex<double> z1 = std::polar (1.0, -2.0 * kPi * hz / sampleRate);
+    const std::complex<double> z2 = z1 * z1;
+
+    auto f = [toFloat] (double x) { return toFloat ? (double) (float) x : x; };
+
+    const auto num = f (gain * c.b0) + f (gain * c.b1) * z1 + f (gain * c.b2) * z2;
+    const auto den = 1.0 + f (c.a1) * z1 + f (c.a2) * z2;
+
+    return 20.0 * std::log10 (std::abs (num / den));
+}
+
+// Worst |float fit - exact reference| (dB), 20 Hz .. min (20 kHz, 0.45 sr)
+double measuredErrorDb (const DsmCaptureFit::Section* reference, int numReference,
+                        const DsmCaptureFit::Fit& fit, double sampleRate)
+{
+    const double lowHz = 20.0, topHz = std::min (20000.0, 0.45 * sampleRate);
+    const double flat  = std::pow (10.0, fit.gainDb / 20.0);
+
+    double worst = 0.0;
+
+    for (int k = 0; k < kPoints; ++k)
+    {
+        const double hz = lowHz * std::pow (topHz / lowHz, (double) k / (kPoints - 1));
+
+        double refDb = 0.0, fitDb = 0.0;
+
+        for (int i = 0; i < numReference; ++i)
+            refDb += biquadDb (DsmCaptureFit::coefficients (reference[i], sampleRate), 1.0, hz, sampleRate, false);
+
+        for (int i = 0; i < fit.numSections; ++i)
+            fitDb += biquadDb (DsmCaptureFit::coefficients (fit.sections[i], sampleRate), i == 0 ? flat : 1.0, hz, sampleRate, true);
+
+        worst = std::max (worst, std::abs (fitDb - refDb));
+    }
+
+    return worst;
+}
+} // namespace
+
+int main()
+{
+    TestUtil::Checks checks;
+
+    DsmCaptureFit::Section capture[DsmCaptureFit::kCaptureBands];
+    DsmCaptureFit::captureReference (capture);
+
+    for (const double sampleRate : { 44100.0, 48000.0, 88200.0, 96000.0, 192000.0 })
+    {
+        const auto fit = DsmCaptureFit::fitWithin (capture, DsmCaptureFit::kCaptureBands, sampleRate,
+                                                   kMinSections, kMaxSections, kToleranceDb);
+        const double measured = measuredErrorDb (capture, DsmCaptureFit::kCaptureBands, fit, sampleRate);
+
+        char what[96];
+        std::snprintf (what, sizeof (what), "%g Hz: fit maxErrorDb (%d sections)", sampleRate, fit.numSections);
+        checks.expect (fit.maxErrorDb <= kToleranceDb && fit.numSections <= kMaxSections, what, fit.maxErrorDb, kToleranceDb);
+
+        std::snprintf (what, sizeof (what), "%g Hz: measured error, float coefficients (dB)", sampleRate);
+        checks.expect (measured <= kToleranceDb, what, measured, kToleranceDb);
+
+        std::snprintf (what, sizeof (what), "%g Hz: measured - reported error (dB)", sampleRate);
+        checks.expect (std::abs (measured - fit.maxErrorDb) <= 0.02, what, measured - fit.maxErrorDb, 0.02);
+    }
+
+    // A reference no low-order fit follows: the fallback must trigger
+    {
+        DsmCaptureFit::Section jagged[DsmCaptureFit::kCaptureBands];
+
+        for (int i = 0; i < DsmCaptureFit::kCaptureBands; ++i)
+            jagged[i] = { DsmCaptureFit::Shape::peak, (double) DsmCaptureFit::kCaptureCentersHz[i], 4.0,
+                          (i % 2 == 0) ? 6.0 : -6.0 };
+
+        const double sampleRate = 48000.0;
+        const auto fit = DsmCaptureFit::fitWithin (jagged, DsmCaptureFit::kCaptureBands, sampleRate,
+                                                   kMinSections, kMaxSections, kToleranceDb);
+        const double measured = measuredErrorDb (jagged, DsmCaptureFit::kCaptureBands, fit, sampleRate);
+
+        checks.expect (fit.maxErrorDb > kToleranceDb,   "jagged: reported error above tolerance (falls back)", fit.maxErrorDb, kToleranceDb);
+        checks.expect (fit.numSections == kMaxSections, "jagged: every section count tried", fit.numSections, kMaxSections);
+        checks.expect (measured > kToleranceDb,         "jagged: measured error above tolerance", measured, kToleranceDb);
+    }
+
+    return checks.exitCode();
+}
@@ -0,0 +1,120 @@
+// FastMath::tanh and tanhBlock against double tanh, for every float with
+// |x| <= 20, plus the saturation, odd-symmetry and NaN behaviour.
+//
+// FastMath.h promises max 7 ulp (vs double tanh rounded to float) and max
+// abs error 4.2e-7 on [-20, 20].
+
+#include "TestUtil.h"
+#include "../Source/FastMath.h"
+
+#include <limits>
+#include <vector>
+
+struct Errors
+{
+    int64_t ulp      = 0;
+    double  abs      = 0.0;
+    int64_t odd      = 0;   // samples where f (-x) != -f (x), bitwise
+    int64_t notUnity = 0;   // x >= kTanhClamp not returning exactly 1
+};
+
+// Positive half against the reference; the negative half is checked for
+// exact odd symmetry, which carries the bound over
+template <typename Eval>
+static Errors sweep (Eval&& eval)
+{
+    constexpr int kBlock = 4096;
+
+    std::vector<float> in, pos, neg;
+    in.reserve (kBlock);
+    pos.resize (kBlock);
+    neg.resize (kBlock);
+
+    Errors e;
+
+    auto flush = [&]
+    {
+        const int n = (int) in.size();
+
+        for (int i = 0; i < n; ++i)
+        {
+            pos[(size_t) i] = in[(size_t) i];
+            neg[(size_t) i] = -in[(size_t) i];
+        }
+
+        eval (pos.data(), n);
+        eval (neg.data(), n);
+
+        for (int i = 0; i < n; ++i)
+        {
+            const float x     = in[(size_t) i];
+            const float y     = pos[(size_t) i];
+            const double ref  = std::tanh ((double) x);
+            const int64_t ulp = TestUtil::ulpDistance (y, (float) ref);
+            const double abs  = std::abs ((double) y - ref);
+
+            e.ulp = ulp > e.ulp ? ulp : e.ulp;
+            e.abs = abs > e.abs ? abs : e.abs;
+            e.odd += (TestUtil::bitsOf (neg[(size_t) i]) != TestUtil::bitsOf (-y)) ? 1 : 0;
+            e.notUnity += (x >= FastMath::kTanhClamp && y != 1.0f) ? 1 : 0;
+        }
+
+        in.clear();
+    };
+
+    TestUtil::forEachFloat (0.0f, 20.0f, [&] (float x)
+    {
+        in.push_back (x);
+        if ((int) in.size() == kBlock)
+            flush();
+    });
+
+    flush();
+    return e;
+}
+
+static void expectErrors (TestUtil::Checks& checks, const Errors& e, const char* name)
+{
+    char what[96];
+
+    std::snprintf (what, sizeof (what), "%s, x in [-20, 20] (ulp)", name);
+    checks.expect (e.ulp <= 7, what, (double) e.ulp, 7);
+
+    std::snprintf (what, sizeof (what), "%s, x in [-20, 20] (abs)", name);
+    checks.expect (e.abs <= 4.2e-7, what, e.abs, 4.2e-7);
+
+    std::snprintf (what, sizeof (what), "%s, f (-x) != -f (x) (count)", name);
+    checks.expect (e.odd == 0, what, (double) e.odd, 0);
+
+    std::snprintf (what, sizeof (what), "%s, x >= kTanhClamp not 1 (count)", name);
+    checks.expect (e.notUnity == 0, what, (double) e.notUnity, 0);
+}
+
+int main()
+{
+    TestUtil::Checks checks;
+
+    expectErrors (checks, sweep ([] (float* d, int n) { for (int i = 0; i < n; ++i) d[i] = FastMath::tanh (d[i]); }),
+                  "tanh");
+    expectErrors (checks, sweep ([] (float* d, int n) { FastMath::tanhBlock (d, n); }),
+                  "tanhBlock");
+
+    // NaN propagates and infinities saturate, scalar and SIMD alike
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    float special[8] = { nan, -nan, inf, -inf, nan, -nan, inf, -inf };
+    FastMath::tanhBlock (special, 8);
+
+    const bool scalarOk = std::isnan (FastMath::tanh (nan)) && std::isnan (FastMath::tanh (-nan))
+                          && FastMath::tanh (inf) == 1.0f && FastMath::tanh (-inf) == -1.0f;
+    bool blockOk = true;
+    for (int i = 0; i < 8; i += 4)
+        blockOk = blockOk && std::isnan (special[i]) && std::isnan (special[i + 1])
+                  && special[i + 2] == 1.0f && special[i + 3] == -1.0f;
+
+    checks.expect (scalarOk, "tanh: NaN -> NaN, +-inf -> +-1", scalarOk ? 1 : 0, 1);
+    checks.expect (blockOk,  "tanhBlock: NaN -> NaN, +-inf -> +-1", blockOk ? 1 : 0, 1);
+
+    return checks.exitCode();
+}
@@ -0,0 +1,62 @@
+// DIGITAL clip kernel timings: full-range LUT (scalar processSample), the
+// block kernel on the compact LUT, and the block kernel on the polynomial.
+// Not a ctest test; run it by hand on the machine you care about.
+//
+// Input is lowpassed noise peaking ~3 dB over the ceiling, so most samples
+// take the knee path rather than the identity below it.
+
+#include "../Source/FruityMatchBlock.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace FruityMatch;
+
+int main()
+{
+    constexpr int kSamples = 1 << 16;
+    constexpr int kBlock   = 512;
+    constexpr int kRuns    = 200;
+
+    std::vector<float> source ((size_t) kSamples), work ((size_t) kSamples);
+
+    uint32_t seed = 0x9e3779b9u;
+    float low = 0.0f;
+
+    for (auto& s : source)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        low  = 0.9f * low + 0.1f * ((float) (seed >> 8) * (2.0f / 16777216.0f) - 1.0f);
+        s    = 4.0f * low;
+    }
+
+    float sink = 0.0f;
+
+    auto time = [&] (const char* name, auto&& kernel)
+    {
+        double best = 1.0e30;
+
+        for (int run = 0; run < kRuns; ++run)
+        {
+            work = source;
+
+            const auto t0 = std::chrono::steady_clock::now();
+            for (int start = 0; start < kSamples; start += kBlock)
+                kernel (work.data() + start, kBlock);
+            const auto t1 = std::chrono::steady_clock::now();
+
+            best = std::min (best, std::chrono::duration<double, std::nano> (t1 - t0).count() / kSamples);
+            sink += work[(size_t) run];
+        }
+
+        std::printf ("%-28s %7.3f ns/sample\n", name, best);
+    };
+
+    time ("full LUT, scalar",      [] (float* d, int n) { for (int i = 0; i < n; ++i) d[i] = processSample (d[i]); });
+    time ("compact LUT, block",    [] (float* d, int n) { processBlock (d, n, Curve::kneeLut); });
+    time ("polynomial, block",     [] (float* d, int n) { processBlock (d, n, Curve::polynomial); });
+
+    return sink == 12345.0f ? 1 : 0;
+}
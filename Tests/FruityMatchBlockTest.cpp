@@ -0,0 +1,62 @@
+// FruityMatch::processBlock (SSE2 / AVX2 / NEON) against the scalar
+// clipSample<Curve>, for every float with |x| <= 2, both curves.
+//
+// FruityMatchBlock.h promises the same result within 1 ulp (bit-identical
+// unless the compiler contracts the scalar path into FMAs).
+
+#include "TestUtil.h"
+#include "../Source/FruityMatchBlock.h"
+
+#include <vector>
+
+using namespace FruityMatch;
+
+template <Curve curve>
+static int64_t worstUlp (float sign)
+{
+    constexpr int kBlock = 4096;
+
+    std::vector<float> in, out;
+    in.reserve (kBlock);
+    out.resize (kBlock);
+
+    int64_t worst = 0;
+
+    auto flush = [&]
+    {
+        std::copy (in.begin(), in.end(), out.begin());
+        processBlock (out.data(), (int) in.size(), curve);
+
+        for (size_t i = 0; i < in.size(); ++i)
+        {
+            const int64_t d = TestUtil::ulpDistance (out[i], clipSample<curve> (in[i]));
+            worst = d > worst ? d : worst;
+        }
+
+        in.clear();
+    };
+
+    TestUtil::forEachFloat (0.0f, 2.0f, [&] (float x)
+    {
+        in.push_back (sign * x);
+        if ((int) in.size() == kBlock)
+            flush();
+    });
+
+    flush();
+    return worst;
+}
+
+int main()
+{
+    TestUtil::Checks checks;
+
+    auto check = [&checks] (int64_t ulp, const char* what) { checks.expect (ulp <= 1, what, (double) ulp, 1); };
+
+    check (worstUlp<Curve::kneeLut> (1.0f),     "kneeLut block vs scalar, x in [0, 2] (ulp)");
+    check (worstUlp<Curve::kneeLut> (-1.0f),    "kneeLut block vs scalar, x in [-2, 0] (ulp)");
+    check (worstUlp<Curve::polynomial> (1.0f),  "polynomial block vs scalar, x in [0, 2] (ulp)");
+    check (worstUlp<Curve::polynomial> (-1.0f), "polynomial block vs scalar, x in [-2, 0] (ulp)");
+
+    return checks.exitCode();
+}
@@ -0,0 +1,68 @@
+// Table-free Fruity knee (FruityMatchPoly.h) against the full-range LUT,
+// for every float in [0, kXMax] and on to the saturated region.
+//
+// Bounds are the ones documented in FruityMatchPoly.h and
+// fruity_knee_lut_compact.h, rounded up to two significant digits.
+
+#include "TestUtil.h"
+#include "../Source/FruityMatchBlock.h"
+
+#include <algorithm>
+
+using namespace FruityMatch;
+
+int main()
+{
+    TestUtil::Checks checks;
+
+    // Knee evaluators vs processSample() on the knee span
+    double polyErr = 0.0, compactErr = 0.0;
+
+    TestUtil::forEachFloat (kKneeStart, kXMax, [&] (float x)
+    {
+        const double ref = processSample (x);
+        polyErr    = std::max (polyErr,    std::abs (processPolySample (x) - ref));
+        compactErr = std::max (compactErr, std::abs (processKneeSample (x) - ref));
+    });
+
+    checks.expect (polyErr <= 2.0e-6,    "polynomial vs full LUT, [kKneeStart, kXMax]", polyErr, 2.0e-6);
+    checks.expect (compactErr <= 1.3e-6, "compact LUT vs full LUT, [kKneeStart, kXMax]", compactErr, 1.3e-6);
+
+    // The DIGITAL curve as the clipper runs it (identity below the knee, blend),
+    // polynomial vs LUT mode over the whole [0, kXMax]
+    double clipErr = 0.0;
+    int    steps   = 0;     // decreasing steps of the polynomial curve
+    int64_t worstStep = 0;  // their size in ulp
+    float  prev    = 0.0f;
+
+    TestUtil::forEachFloat (0.0f, kXMax, [&] (float x)
+    {
+        const float y = clipSample<Curve::polynomial> (x);
+        clipErr = std::max (clipErr, (double) std::abs (y - clipSample<Curve::kneeLut> (x)));
+
+        if (y < prev)
+        {
+            ++steps;
+            worstStep = std::max (worstStep, TestUtil::ulpDistance (y, prev));
+        }
+
+        prev = y;
+    });
+
+    checks.expect (clipErr <= 2.0e-6,  "clipSample polynomial vs LUT mode, [0, kXMax]", clipErr, 2.0e-6);
+    checks.expect (steps <= 1,         "polynomial decreasing steps, [0, kXMax]", steps, 1);
+    checks.expect (worstStep <= 1,     "polynomial decreasing step size (ulp)", (double) worstStep, 1);
+
+    // Saturation: both modes hold the LUT end value above kXMax
+    double satErr = 0.0;
+
+    TestUtil::forEachFloat (kXMax, 4.0f, [&] (float x)
+    {
+        satErr = std::max (satErr, (double) std::abs (clipSample<Curve::polynomial> (x) - kFullRangeLut.back()));
+        satErr = std::max (satErr, (double) std::abs (clipSample<Curve::kneeLut> (x)    - kFullRangeLut.back()));
+    });
+
+    checks.expect (satErr == 0.0, "saturated value above kXMax", satErr, 0.0);
+
+    return checks.exitCode();
+}
@@ -0,0 +1,113 @@
+// StereoHalfbandOversampler against juce::dsp::Oversampling, stereo up +
+// down over 512-sample blocks, per quality tier and factor x2 .. x64: ns per
+// base-rate sample (best of kRuns) for each, and JUCE / SIMD. JUCE's stages
+// are built from getHalfbandStageSpec as the processor's fallback builds
+// them (FIR stages as JUCE's equiripple FIR). Not a ctest test; run it by
+// hand on the machine you care about.
+//
+// Links JUCE (juce::dsp::Oversampling); see Tests/CMakeLists.txt.
+
+#include "../Source/StereoHalfbandOversampler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace {
+constexpr int kBlock   = 512;
+constexpr int kSamples = 1 << 15;
+constexpr int kRuns    = 15;
+
+std::unique_ptr<juce::dsp::Oversampling<float>> makeJuce (OversamplingQuality quality, int numStages)
+{
+    using Oversampling = juce::dsp::Oversampling<float>;
+    auto os = std::make_unique<Oversampling> (2);
+
+    for (int n = 0; n < numStages; ++n)
+    {
+        const auto spec = getHalfbandStageSpec (quality, n);
+        os->addOversamplingStage (spec.fir ? Oversampling::filterHalfBandFIREquiripple
+                                           : Oversampling::filterHalfBandPolyphaseIIR,
+                                  spec.twUp, spec.dBUp, spec.twDown, spec.dBDown);
+    }
+
+    os->setUsingIntegerLatency (true);
+    return os;
+}
+
+// Best-of-kRuns ns per base-rate sample for up + down through os
+template <typename Engine>
+double timeEngine (Engine& os, juce::AudioBuffer<float>& source, juce::AudioBuffer<float>& block, float& sink)
+{
+    os.initProcessing ((size_t) kBlock);
+
+    double best = 1.0e30;
+
+    for (int run = 0; run < kRuns; ++run)
+    {
+        os.reset();
+
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int start = 0; start < kSamples; start += kBlock)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                block.copyFrom (ch, 0, source, ch, start, kBlock);
+
+            juce::dsp::AudioBlock<float> io (block);
+            os.processSamplesUp (io);
+            os.processSamplesDown (io);
+            sink += block.getSample (0, 0) + block.getSample (1, kBlock - 1);
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+
+        best = std::min (best, std::chrono::duration<double, std::nano> (t1 - t0).count() / kSamples);
+    }
+
+    return best;
+}
+} // namespace
+
+int main()
+{
+    juce::AudioBuffer<float> source (2, kSamples), block (2, kBlock);
+
+    uint32_t seed = 0x9e3779b9u;
+    for (int i = 0; i < kSamples; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const float x = (float) (seed >> 8) * (1.0f / 16777216.0f) - 0.5f;
+        source.setSample (0, i, x);
+        source.setSample (1, i, -0.5f * x);
+    }
+
+    const struct { OversamplingQuality quality; const char* name; } tiers[] =
+    {
+        { OversamplingQuality::eco,      "eco" },
+        { OversamplingQuality::balanced, "balanced" },
+        { OversamplingQuality::max,      "max" },
+    };
+
+    float sink = 0.0f;
+
+    std::printf ("%-10s %6s %10s %10s %8s\n", "tier", "factor", "SIMD ns", "JUCE ns", "JUCE/SIMD");
+
+    for (const auto& tier : tiers)
+    {
+        for (int numStages = 1; numStages <= 6; ++numStages)
+        {
+            StereoHalfbandOversampler simd (2, numStages, tier.quality);
+            auto reference = makeJuce (tier.quality, numStages);
+
+            const double simdNs = timeEngine (simd, source, block, sink);
+            const double juceNs = timeEngine (*reference, source, block, sink);
+
+            std::printf ("%-10s %6d %10.2f %10.2f %8.2f\n", tier.name, 1 << numStages, simdNs, juceNs, juceNs / simdNs);
+        }
+    }
+
+    std::printf ("(%g)\n", (double) sink);
+    return 0;
+}
@@ -0,0 +1,163 @@
+// StereoHalfbandOversampler against juce::dsp::Oversampling (polyphase IIR
+// halfbands, integer latency), per factor x2 .. x64 and quality tier:
+//
+//   up    – the oversampled blocks, both channels
+//   down  – the round trip, with a tanh between up and down so the down path
+//           sees content above the base band
+//   latency – both report the same (integer) latency
+//
+// JUCE's stages are built from getHalfbandStageSpec (the processor's
+// fallback for more than two channels). Only all-IIR cascades can null –
+// max at every factor, eco and balanced at x2 – since the lower tiers' FIR
+// stages are Kaiser designs JUCE has no counterpart for; those are covered
+// by Tests/OversamplingTierTest. The engines run the same filters in the
+// same operation order, so the null is float rounding (exact without FMA
+// contraction). L and R get independent noise, so a lane mix-up shows.
+//
+// Links JUCE (juce::dsp::Oversampling); see Tests/CMakeLists.txt.
+
+#include "TestUtil.h"
+#include "../Source/StereoHalfbandOversampler.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+constexpr int kMaxBlock  = 512;
+constexpr int kNumBlocks = 48;
+
+std::unique_ptr<juce::dsp::Oversampling<float>> makeJuce (OversamplingQuality quality, int numStages)
+{
+    using Oversampling = juce::dsp::Oversampling<float>;
+
+    auto os = std::make_unique<Oversampling> (2);
+
+    for (int n = 0; n < numStages; ++n)
+    {
+        const auto spec = getHalfbandStageSpec (quality, n);
+        os->addOversamplingStage (Oversampling::filterHalfBandPolyphaseIIR,
+                                  spec.twUp, spec.dBUp, spec.twDown, spec.dBDown);
+    }
+
+    os->setUsingIntegerLatency (true);
+    return os;
+}
+
+struct Null
+{
+    double up = 0.0, down = 0.0;   // worst abs difference
+    float  latency = 0.0f, juceLatency = 0.0f;
+};
+
+Null runNull (OversamplingQuality quality, int numStages)
+{
+    StereoHalfbandOversampler simd (2, numStages, quality);
+    auto reference = makeJuce (quality, numStages);
+
+    simd.initProcessing ((size_t) kMaxBlock);
+    reference->initProcessing ((size_t) kMaxBlock);
+    reference->reset();
+
+    Null result;
+    result.latency     = simd.getLatencyInSamples();
+    result.juceLatency = reference->getLatencyInSamples();
+
+    uint32_t seed = 0x9e3779b9u;
+    auto noise = [&seed]
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return (float) (seed >> 8) * (1.0f / 16777216.0f) - 0.5f;
+    };
+
+    juce::AudioBuffer<float> a (2, kMaxBlock), b (2, kMaxBlock);
+
+    for (int block = 0; block < kNumBlocks; ++block)
+    {
+        // Odd sizes too, so state carries across ragged blocks
+        const int n = (block % 3 == 2) ? 173 : kMaxBlock;
+
+        for (int i = 0; i < n; ++i)
+        {
+            const float left = noise(), right = noise();
+            a.setSample (0, i, left);   b.setSample (0, i, left);
+            a.setSample (1, i, right);  b.setSample (1, i, right);
+        }
+
+        auto blockA = juce::dsp::AudioBlock<float> (a).getSubBlock (0, (size_t) n);
+        auto blockB = juce::dsp::AudioBlock<float> (b).getSubBlock (0, (size_t) n);
+
+        auto upA = simd.processSamplesUp (blockA);
+        auto upB = reference->processSamplesUp (blockB);
+
+        for (size_t ch = 0; ch < 2; ++ch)
+        {
+            float* x = upA.getChannelPointer (ch);
+            float* y = upB.getChannelPointer (ch);
+
+            for (size_t i = 0; i < upA.getNumSamples(); ++i)
+            {
+                result.up = std::max (result.up, (double) std::abs (x[i] - y[i]));
+                x[i] = std::tanh (3.0f * x[i]);
+                y[i] = std::tanh (3.0f * y[i]);
+            }
+        }
+
+        simd.processSamplesDown (blockA);
+        reference->processSamplesDown (blockB);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < n; ++i)
+                result.down = std::max (result.down, (double) std::abs (a.getSample (ch, i) - b.getSample (ch, i)));
+    }
+
+    return result;
+}
+} // namespace
+
+int main()
+{
+    TestUtil::Checks checks;
+
+    constexpr double kBound = 1.0e-5;   // -100 dB re the 0.5 peak noise
+
+    const struct { OversamplingQuality quality; const char* name; } tiers[] =
+    {
+        { OversamplingQuality::eco,      "eco" },
+        { OversamplingQuality::balanced, "balanced" },
+        { OversamplingQuality::max,      "max" },
+    };
+
+    for (const auto& tier : tiers)
+    {
+        for (int numStages = 1; numStages <= 6; ++numStages)
+        {
+            bool allIir = true;
+            for (int n = 0; n < numStages; ++n)
+                allIir = allIir && ! getHalfbandStageSpec (tier.quality, n).fir;
+
+            if (! allIir)
+                continue;
+
+            const auto r = runNull (tier.quality, numStages);
+            const int factor = 1 << numStages;
+            char what[96];
+
+            std::snprintf (what, sizeof (what), "%s x%d up vs JUCE (abs)", tier.name, factor);
+            checks.expect (r.up <= kBound, what, r.up, kBound);
+
+            std::snprintf (what, sizeof (what), "%s x%d up + down vs JUCE (abs)", tier.name, factor);
+            checks.expect (r.down <= kBound, what, r.down, kBound);
+
+            // Integer latency: both must report the same whole number of samples
+            const double latencyDifference = std::abs ((double) r.latency - (double) r.juceLatency);
+            std::snprintf (what, sizeof (what), "%s x%d latency %.3f vs JUCE %.3f", tier.name, factor,
+                           (double) r.latency, (double) r.juceLatency);
+            checks.expect (latencyDifference <= 1.0e-3
+                             && juce::roundToInt (r.latency) == juce::roundToInt (r.juceLatency),
+                           what, latencyDifference, 1.0e-3);
+        }
+    }
+
+    return checks.exitCode();
+}
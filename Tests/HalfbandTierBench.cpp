@@ -0,0 +1,79 @@
+// Halfband::Cascade timings per OversamplingQuality tier and factor: stereo
+// up + down over 512-sample blocks, ns per base-rate sample (best of
+// kRuns), with the reported latency and the section / tap-pair count per
+// stage. Not a ctest test; run it by hand on the machine you care about.
+// HalfbandCascade.h's table comes from here.
+
+#include "../Source/HalfbandCascade.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+int main()
+{
+    constexpr int kBlock   = 512;
+    constexpr int kSamples = 1 << 15;
+    constexpr int kRuns    = 15;
+
+    std::vector<float> left ((size_t) kSamples), right ((size_t) kSamples), outL ((size_t) kBlock), outR ((size_t) kBlock);
+
+    uint32_t seed = 0x9e3779b9u;
+    for (int i = 0; i < kSamples; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        left[(size_t) i]  = (float) (seed >> 8) * (1.0f / 16777216.0f) - 0.5f;
+        right[(size_t) i] = -0.5f * left[(size_t) i];
+    }
+
+    const struct { OversamplingQuality quality; const char* name; } tiers[] =
+    {
+        { OversamplingQuality::eco,      "eco" },
+        { OversamplingQuality::balanced, "balanced" },
+        { OversamplingQuality::max,      "max" },
+    };
+
+    float sink = 0.0f;
+
+    std::printf ("%-10s %6s %10s %8s   stages (IIR sections / FIR tap pairs, up + down)\n",
+                 "tier", "factor", "ns/sample", "latency");
+
+    for (const auto& tier : tiers)
+    {
+        for (int numStages = 1; numStages <= 6; ++numStages)
+        {
+            Halfband::Cascade cascade (2, numStages, tier.quality);
+            cascade.prepare (kBlock);
+
+            double best = 1.0e30;
+
+            for (int run = 0; run < kRuns; ++run)
+            {
+                cascade.reset();
+
+                const auto t0 = std::chrono::steady_clock::now();
+                for (int start = 0; start < kSamples; start += kBlock)
+                {
+                    cascade.processUp (left.data() + start, right.data() + start, kBlock);
+                    cascade.processDown (outL.data(), outR.data(), kBlock);
+                    sink += outL[0] + outR[(size_t) kBlock - 1];
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+
+                best = std::min (best, std::chrono::duration<double, std::nano> (t1 - t0).count() / kSamples);
+            }
+
+            std::printf ("%-10s %6d %10.2f %8.0f  ", tier.name, 1 << numStages, best, (double) cascade.getLatency());
+
+            for (int s = 0; s < numStages; ++s)
+                std::printf (" %s%d", cascade.isFirStage (s) ? "F" : "I", cascade.getStageOrder (s));
+
+            std::printf ("\n");
+        }
+    }
+
+    std::printf ("(%g)\n", (double) sink);
+    return 0;
+}
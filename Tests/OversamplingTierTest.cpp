@@ -0,0 +1,241 @@
+// OversamplingQuality tiers, measured through Halfband::Cascade (the engine
+// every mono / stereo bus runs) at 44.1 kHz, per tier and factor:
+//
+//   passband – up -> down gain of tones 1 .. 20 kHz (ripple, dB)
+//   images   – up path: level of the images k fs +- f of in-band tones
+//   aliases  – down path: gain of oversampled-rate tones k fs +- f that fold
+//              back onto f
+//   latency  – phase delay of a 200 Hz tone against the reported latency
+//
+// with f in 0 .. 16 kHz, the band the HalfbandCascade.h table covers. Levels
+// are read with a Hann-windowed single-bin DFT after the filters settle, so
+// neighbouring tones leak in well below the -80 dB we resolve.
+//
+// The tiers must be ordered: max no worse than balanced, balanced no worse
+// than eco, at every factor.
+
+#include "TestUtil.h"
+#include "../Source/HalfbandCascade.h"
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+namespace {
+constexpr double kRate      = 44100.0;
+constexpr double kTwoPi     = 2.0 * Halfband::kPi;
+constexpr int    kBlock     = 512;    // base-rate samples per up / down call
+constexpr int    kSettle    = 4096;   // base-rate samples before measuring
+constexpr int    kMeasure   = 4096;
+
+const double kTones[] = { 1000.0, 4000.0, 8000.0, 12000.0, 16000.0 };
+
+// Cycles-per-sample component of x, Hann-windowed: amplitude and phase
+std::complex<double> toneOf (const float* x, int n, double cyclesPerSample)
+{
+    const double w = kTwoPi * cyclesPerSample;
+    const std::complex<double> step = std::polar (1.0, -w);
+
+    std::complex<double> rotor (1.0, 0.0), sum (0.0, 0.0);
+    double windowSum = 0.0;
+
+    for (int i = 0; i < n; ++i)
+    {
+        const double window = 0.5 - 0.5 * std::cos (kTwoPi * (i + 0.5) / n);
+        sum       += window * (double) x[i] * rotor;
+        windowSum += window;
+        rotor     *= step;
+    }
+
+    return 2.0 * sum / windowSum;
+}
+
+double toneLevel (const float* x, int n, double cyclesPerSample) { return std::abs (toneOf (x, n, cyclesPerSample)); }
+
+double toDb (double gain) { return 20.0 * std::log10 (std::max (gain, 1.0e-12)); }
+
+struct Measured
+{
+    double rippleDb     = 0.0;        // max |passband gain| over the tones
+    double imageDb      = -300.0;     // worst up-path image
+    double aliasDb      = -300.0;     // worst down-path alias
+    double latencyError = 0.0;        // |measured - reported| latency, base-rate samples
+};
+
+// Base-rate tone at f through up -> down. Returns the settled output; the
+// settled up-path output goes to oversampled.
+std::vector<float> runTone (Halfband::Cascade& os, double f, std::vector<float>& oversampled)
+{
+    const int factor = os.getFactor();
+    const int total  = kSettle + kMeasure;
+
+    std::vector<float> in ((size_t) kBlock), block ((size_t) kBlock), out ((size_t) kMeasure);
+    oversampled.assign ((size_t) (kMeasure * factor), 0.0f);
+    os.reset();
+
+    for (int start = 0; start < total; start += kBlock)
+    {
+        for (int i = 0; i < kBlock; ++i)
+            in[(size_t) i] = (float) (0.5 * std::sin (kTwoPi * f * (start + i) / kRate));
+
+        os.processUp (in.data(), in.data(), kBlock);
+
+        if (start >= kSettle)
+            std::copy (os.getUpsampled (0), os.getUpsampled (0) + kBlock * factor,
+                       oversampled.begin() + (start - kSettle) * factor);
+
+        os.processDown (block.data(), nullptr, kBlock);
+
+        if (start >= kSettle)
+            std::copy (block.begin(), block.end(), out.begin() + (start - kSettle));
+    }
+
+    return out;
+}
+
+// Oversampled-rate tone at g (Hz) into the down path; level at its fold-back
+double aliasGain (Halfband::Cascade& os, double g, double folded)
+{
+    const int factor = os.getFactor();
+    const int total  = kSettle + kMeasure;
+
+    std::vector<float> silence ((size_t) kBlock, 0.0f), out ((size_t) kMeasure), block ((size_t) kBlock);
+    os.reset();
+
+    for (int start = 0; start < total; start += kBlock)
+    {
+        os.processUp (silence.data(), silence.data(), kBlock);
+
+        for (int ch = 0; ch < os.getNumChannels(); ++ch)
+            for (int i = 0; i < kBlock * factor; ++i)
+                os.getUpsampled (ch)[i] = (float) (0.5 * std::sin (kTwoPi * g * ((double) start * factor + i)
+                                                                      / (kRate * factor)));
+
+        os.processDown (block.data(), nullptr, kBlock);
+
+        if (start >= kSettle)
+            std::copy (block.begin(), block.end(), out.begin() + (start - kSettle));
+    }
+
+    return toneLevel (out.data(), kMeasure, folded / kRate) / 0.5;
+}
+
+Measured measure (OversamplingQuality quality, int numStages)
+{
+    Halfband::Cascade os (2, numStages, quality);
+    os.prepare (kBlock);
+
+    const int factor = 1 << numStages;
+    const double highRate = kRate * factor;
+
+    Measured m;
+    std::vector<float> oversampled;
+
+    for (double f = 1000.0; f <= 20000.0; f += 1000.0)
+    {
+        const auto out = runTone (os, f, oversampled);
+        m.rippleDb = std::max (m.rippleDb, std::abs (toDb (toneLevel (out.data(), kMeasure, f / kRate) / 0.5)));
+    }
+
+    // Phase delay at 200 Hz: output phase against the input's at the same window
+    {
+        constexpr double f = 200.0;
+        const auto out = runTone (os, f, oversampled);
+
+        std::vector<float> in ((size_t) kMeasure);
+        for (int i = 0; i < kMeasure; ++i)
+            in[(size_t) i] = (float) (0.5 * std::sin (kTwoPi * f * (kSettle + i) / kRate));
+
+        const double w     = kTwoPi * f / kRate;
+        const double phase = std::arg (toneOf (in.data(), kMeasure, f / kRate) / toneOf (out.data(), kMeasure, f / kRate));
+        const double lag   = std::remainder (phase, kTwoPi) / w;
+        const double whole = std::round ((os.getLatency() - lag) * w / kTwoPi) * kTwoPi / w;   // 2 pi ambiguity
+        m.latencyError = std::abs (lag + whole - os.getLatency());
+    }
+
+    for (double f : kTones)
+    {
+        runTone (os, f, oversampled);
+
+        for (int k = 1; k <= factor / 2; ++k)
+        {
+            for (double g : { k * kRate - f, k * kRate + f })
+            {
+                if (g >= highRate * 0.5)
+                    continue;
+
+                const double image = toneLevel (oversampled.data(), kMeasure * factor, g / highRate) / 0.5;
+                m.imageDb = std::max (m.imageDb, toDb (image));
+                m.aliasDb = std::max (m.aliasDb, toDb (aliasGain (os, g, f)));
+            }
+        }
+    }
+
+    return m;
+}
+
+// The HalfbandCascade.h table; images / aliases get 0.5 dB of headroom
+struct Expected
+{
+    OversamplingQuality quality;
+    const char* name;
+    double rippleDb;     // bound, all factors
+    double worstDb[6];   // max (image, alias), x2 .. x64
+};
+
+const Expected kExpected[] =
+{
+    { OversamplingQuality::eco,      "eco",      0.075,  { -62.2, -62.3, -57.8, -61.5, -61.5, -61.5 } },
+    { OversamplingQuality::balanced, "balanced", 0.006,  { -71.2, -73.8, -73.8, -73.8, -73.8, -73.8 } },
+    { OversamplingQuality::max,      "max",      0.001,  { -80.4, -77.3, -77.7, -77.7, -77.7, -77.7 } },
+};
+} // namespace
+
+int main()
+{
+    TestUtil::Checks checks;
+
+    double worst[3][6] = {};
+
+    for (const auto& tier : kExpected)
+    {
+        for (int numStages = 1; numStages <= 6; ++numStages)
+        {
+            const auto m = measure (tier.quality, numStages);
+            const double aliasBound  = tier.worstDb[numStages - 1] + 0.5;
+            const int factor = 1 << numStages;
+
+            worst[(int) tier.quality][numStages - 1] = std::max (m.imageDb, m.aliasDb);
+
+            char what[96];
+            std::snprintf (what, sizeof (what), "%s x%d passband ripple (dB)", tier.name, factor);
+            checks.expect (m.rippleDb <= tier.rippleDb, what, m.rippleDb, tier.rippleDb);
+
+            std::snprintf (what, sizeof (what), "%s x%d images (dB)", tier.name, factor);
+            checks.expect (m.imageDb <= aliasBound, what, m.imageDb, aliasBound);
+
+            std::snprintf (what, sizeof (what), "%s x%d aliases (dB)", tier.name, factor);
+            checks.expect (m.aliasDb <= aliasBound, what, m.aliasDb, aliasBound);
+
+            std::snprintf (what, sizeof (what), "%s x%d latency vs 200 Hz phase delay", tier.name, factor);
+            checks.expect (m.latencyError <= 0.01, what, m.latencyError, 0.01);
+        }
+    }
+
+    // Each tier at least as good as the one below it
+    for (int numStages = 1; numStages <= 6; ++numStages)
+    {
+        const double eco      = worst[(int) OversamplingQuality::eco][numStages - 1];
+        const double balanced = worst[(int) OversamplingQuality::balanced][numStages - 1];
+        const double max      = worst[(int) OversamplingQuality::max][numStages - 1];
+
+        char what[96];
+        std::snprintf (what, sizeof (what), "x%d max - balanced worst (dB)", 1 << numStages);
+        checks.expect (max <= balanced, what, max - balanced, 0.0);
+
+        std::snprintf (what, sizeof (what), "x%d balanced - eco worst (dB)", 1 << numStages);
+        checks.expect (balanced <= eco, what, balanced - eco, 0.0);
+    }
+
+    return checks.exitCode();
+}
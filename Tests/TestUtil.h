@@ -0,0 +1,63 @@
+#pragma once
+// Shared helpers for the DSP tests: float sweeps, ulp distance, and a
+// failure counter that becomes the process exit code.
+//
+// The tests only include headers from Source/ that build without JUCE,
+// unless their target links JUCE (see Tests/CMakeLists.txt).
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace TestUtil {
+
+static inline uint32_t bitsOf (float x) noexcept
+{
+    uint32_t u;
+    std::memcpy (&u, &x, sizeof (u));
+    return u;
+}
+
+static inline float floatOf (uint32_t u) noexcept
+{
+    float x;
+    std::memcpy (&x, &u, sizeof (x));
+    return x;
+}
+
+// Distance in representable floats (same-sign or across zero)
+static inline int64_t ulpDistance (float a, float b) noexcept
+{
+    auto ordered = [] (float x) -> int64_t
+    {
+        const uint32_t u = bitsOf (x);
+        return (u & 0x80000000u) ? -(int64_t) (u & 0x7fffffffu) : (int64_t) u;
+    };
+
+    const int64_t d = ordered (a) - ordered (b);
+    return d < 0 ? -d : d;
+}
+
+// Calls fn (x) for every float in [lo, hi], 0 <= lo <= hi, in ascending order
+template <typename Fn>
+static inline void forEachFloat (float lo, float hi, Fn&& fn)
+{
+    for (uint32_t u = bitsOf (lo), end = bitsOf (hi); u <= end; ++u)
+        fn (floatOf (u));
+}
+
+struct Checks
+{
+    int failures = 0;
+
+    void expect (bool ok, const char* what, double value, double bound)
+    {
+        std::printf ("%-56s %12.4g  (bound %.4g)  %s\n", what, value, bound, ok ? "ok" : "FAIL");
+        failures += ok ? 0 : 1;
+    }
+
+    int exitCode() const { return failures == 0 ? 0 : 1; }
+};
+
+} // namespace TestUtil